@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Document.hpp"
+#include "ValueComparator.hpp"
+
+#include <unordered_map>
+
+/// @brief Function accumulating values of documents in group
+enum class Accumulator {
+    Count,
+    Sum,
+    Min,
+    Max,
+    Avg
+};
+
+/// @brief Single accumulated field of aggregation results
+struct Accumulation {
+    /// @brief Name of field holding result
+    std::string name;
+
+    /// @brief Accumulating function
+    Accumulator accumulator;
+
+    /// @brief Name of accumulated top-level field, unused by Accumulator::Count
+    std::string field;
+};
+
+/// @brief Describes group and accumulate stages of aggregation, e.g. Aggregation().groupBy("category").count("total")
+class Aggregation {
+public:
+    /// @brief Group documents by value of top-level field, without grouping whole match forms one group
+    /// @param field Name of field
+    /// @return This aggregation
+    Aggregation& groupBy(std::string field);
+
+    /// @brief Count documents in group
+    /// @param name Name of field holding result, of type size_t
+    /// @return This aggregation
+    Aggregation& count(std::string name);
+
+    /// @brief Sum numeric values of field in group
+    /// @param name Name of field holding result, of type double
+    /// @param field Name of summed field, non numeric values are skipped
+    /// @return This aggregation
+    Aggregation& sum(std::string name, std::string field);
+
+    /// @brief Find smallest orderable value of field in group
+    /// @param name Name of field holding result, missing if group has no orderable value
+    /// @param field Name of compared field
+    /// @return This aggregation
+    Aggregation& min(std::string name, std::string field);
+
+    /// @brief Find largest orderable value of field in group
+    /// @param name Name of field holding result, missing if group has no orderable value
+    /// @param field Name of compared field
+    /// @return This aggregation
+    Aggregation& max(std::string name, std::string field);
+
+    /// @brief Average numeric values of field in group
+    /// @param name Name of field holding result, of type double, missing if group has no numeric value
+    /// @param field Name of averaged field, non numeric values are skipped
+    /// @return This aggregation
+    Aggregation& avg(std::string name, std::string field);
+
+    /// @brief Get name of grouping field
+    /// @return Name of field, std::nullopt if documents are not grouped
+    const std::optional<std::string>& getGroupField() const { return _groupField; }
+
+    /// @brief Get accumulated fields
+    /// @return Vector of accumulations in order they were added
+    const std::vector<Accumulation>& getAccumulations() const { return _accumulations; }
+
+private:
+    /// @brief Name of grouping field
+    std::optional<std::string> _groupField;
+
+    /// @brief Accumulated fields
+    std::vector<Accumulation> _accumulations;
+};
+
+/// @brief Partial result of aggregation over part of collection, partial results are combined with merge
+class AggregationState {
+public:
+    /// @brief Construct an empty state
+    /// @param aggregation Aggregation, must outlive state
+    explicit AggregationState(const Aggregation& aggregation) : _aggregation(&aggregation) {}
+
+    /// @brief Accumulate document
+    /// @param doc Matched document
+    void add(const Document& doc);
+
+    /// @brief Combine with state of following part of collection
+    /// @param other State of the same aggregation, its new groups go after groups of this state
+    void merge(const AggregationState& other);
+
+    /// @brief Build result documents
+    /// @return One document per group, in order of first appearance, holding group key and accumulated fields
+    std::vector<Document> results() const;
+
+private:
+    /// @brief Accumulated values of single field
+    struct Accumulated {
+        /// @brief Number of numeric values
+        size_t count{0};
+
+        /// @brief Sum of numeric values
+        double sum{0.0};
+
+        /// @brief Smallest orderable value
+        std::optional<Document::Value> min;
+
+        /// @brief Largest orderable value
+        std::optional<Document::Value> max;
+    };
+
+    /// @brief Accumulated values of single group
+    struct Group {
+        /// @brief Value of grouping field, std::nullopt for documents without it
+        std::optional<Document::Value> key;
+
+        /// @brief Number of documents
+        size_t count{0};
+
+        /// @brief Accumulated values, one per accumulation
+        std::vector<Accumulated> accumulated;
+    };
+
+    /// @brief Aggregation
+    const Aggregation* _aggregation;
+
+    /// @brief Groups in order of first appearance
+    std::vector<Group> _groups;
+
+    /// @brief Positions of groups in _groups by key
+    std::unordered_map<Document::Value, size_t, ValueHash, ValueEqual> _positions;
+
+    /// @brief Position of group of documents without grouping field
+    std::optional<size_t> _missingPosition;
+
+    /// @brief Find or create group
+    /// @param key Value of grouping field, nullptr for documents without it
+    /// @return Group
+    Group& group(const Document::Value* key);
+};
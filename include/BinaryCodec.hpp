@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Document.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+/// @brief Encodes documents in compact binary format
+/// @details Encoded document starts with magic "DDB" and version byte, followed by document body. Body is varint number
+/// of fields, each field is varint-prefixed key, type tag byte and payload. Numbers are raw little-endian, strings are
+/// varint-prefixed, vectors and maps are varint number of elements followed by nested bodies.
+class BinaryCodec {
+public:
+    /// @brief Type tags of encoded values, in order of Document::Value alternatives
+    enum class Tag : uint8_t {
+        Int,
+        SizeT,
+        Double,
+        String,
+        Bool,
+        Document,
+        Vector,
+        Map
+    };
+
+    /// @brief Append encoded document to buffer
+    /// @param doc Document to encode
+    /// @param out Buffer to append to
+    static void encode(const Document& doc, std::string& out);
+
+    /// @brief Decode document
+    /// @param data Encoded document, as produced by encode
+    /// @return Decoded document
+    /// @throws std::runtime_error if data is truncated or malformed
+    static Document decode(std::string_view data);
+
+    /// @brief Check if data starts with header of encoded document
+    /// @param data Data to check
+    /// @return True if data is encoded document, false otherwise
+    static bool isEncoded(std::string_view data);
+
+    /// @brief Compute FNV-1a checksum, can be chained over several parts
+    /// @param data Data to hash
+    /// @param seed Checksum of preceding parts
+    /// @return Checksum
+    static uint32_t checksum(std::string_view data, uint32_t seed = 2166136261u);
+
+    /// @brief Append unsigned LEB128 varint
+    /// @param value Value to encode
+    /// @param out Buffer to append to
+    static void writeVarint(uint64_t value, std::string& out);
+
+    /// @brief Append little-endian number
+    /// @param value Value to encode
+    /// @param bytes Number of lowest bytes of value to write
+    /// @param out Buffer to append to
+    static void writeFixed(uint64_t value, size_t bytes, std::string& out);
+
+    /// @brief Append varint length followed by bytes of string
+    /// @param value String to encode
+    /// @param out Buffer to append to
+    static void writeString(std::string_view value, std::string& out);
+
+    /// @brief Cursor over decoded data, every read throws std::runtime_error if data is truncated
+    struct Reader {
+        /// @brief Decoded data
+        std::string_view data;
+
+        /// @brief Position of next unread byte
+        size_t pos{0};
+
+        uint8_t byte();
+        uint64_t varint();
+        uint64_t fixed(size_t bytes);
+        std::string_view string();
+    };
+
+private:
+    /// @brief Magic and version starting every encoded document
+    static constexpr std::string_view header{"DDB\x01"};
+
+    /// @brief Append document body, without header
+    /// @param doc Document to encode
+    /// @param out Buffer to append to
+    static void encodeBody(const Document& doc, std::string& out);
+
+    /// @brief Append type tag and payload of value
+    /// @param value Value to encode
+    /// @param out Buffer to append to
+    static void encodeValue(const Document::Value& value, std::string& out);
+
+    /// @brief Decode document body
+    /// @param reader Reader positioned at body
+    /// @return Decoded document
+    static Document decodeBody(Reader& reader);
+
+    /// @brief Decode type tag and payload of value
+    /// @param reader Reader positioned at type tag
+    /// @return Decoded value
+    static Document::Value decodeValue(Reader& reader);
+};
@@ -1,7 +1,20 @@
+#pragma once
+
+#include "Aggregation.hpp"
+#include "Cursor.hpp"
 #include "Document.hpp"
+#include "FindOptions.hpp"
+#include "HashIndex.hpp"
+#include "IdGenerator.hpp"
 #include "Logger.hpp"
-
-#include <random>
+#include "OrderedIndex.hpp"
+#include "Query.hpp"
+#include "QueryPlan.hpp"
+#include "SlotMap.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <limits>
 #include <unordered_set>
 
 /// @brief Represents a collection with documents
@@ -9,12 +22,23 @@ class Collection {
 public:
     /// @brief Construct a collection
     /// @param name Name of collection
-    Collection(std::string name) : _name(std::move(name)) {}
+    /// @param idStrategy Strategy of generating ids of documents inserted without one
+    Collection(std::string name, IdStrategy idStrategy = IdStrategy::Random) : _name(std::move(name)), _idGenerator(idStrategy) {}
 
     /// @brief Insert document
     /// @param doc Document to be inserted
     void insert(Document& doc);
 
+    /// @brief Insert document, moving it into collection
+    /// @param doc Document to be inserted
+    /// @return Id of inserted document, std::nullopt if it was not inserted
+    std::optional<size_t> insert(Document&& doc);
+
+    /// @brief Insert many documents, documents whose id already exists are skipped
+    /// @param docs Documents to be inserted, moved into collection
+    /// @return Ids of inserted documents, in order of docs
+    std::vector<size_t> insertMany(std::vector<Document> docs);
+
     /// @brief Update documents
     /// @tparam Filter Function
     /// @tparam Modifier Function
@@ -35,6 +59,97 @@ public:
     template<typename Filter>
     std::vector<Document> find(Filter&& filter);
 
+    /// @brief Find documents, scanning partitions of collection concurrently
+    /// @tparam Filter Function, must be safe to call concurrently
+    /// @param filter Function filtering documents
+    /// @param execution Execution mode, Execution::ParallelUnordered does not keep collection order
+    /// @return Vector of copies of found documents
+    template<typename Filter>
+    std::vector<Document> find(Filter&& filter, Execution execution);
+
+    /// @brief Find documents, materializing only projected parts of them
+    /// @tparam Filter Function or query expression
+    /// @param filter Function filtering documents
+    /// @param projection Fields to be kept or dropped
+    /// @return Vector of projected copies of found documents
+    template<typename Filter>
+    std::vector<Document> find(Filter&& filter, const Projection& projection);
+
+    /// @brief Find documents, stopping early once limit is reached
+    /// @tparam Filter Function or query expression
+    /// @param filter Function filtering documents
+    /// @param options Skip, limit, sort and projection of results
+    /// @return Vector of copies of found documents, sorted results are selected with bounded heap of skip + limit size
+    template<typename Filter>
+    std::vector<Document> find(Filter&& filter, const FindOptions& options);
+
+    /// @brief Find documents lazily, without copying them
+    /// @tparam Filter Function or query expression
+    /// @param filter Function filtering documents, query expressions are served from indexes when possible
+    /// @return Cursor yielding references to found documents, invalidated by any modification of collection
+    template<typename Filter>
+    Cursor<std::decay_t<Filter>> findView(Filter&& filter) const;
+
+    /// @brief Get all documents lazily, without copying them
+    /// @return Cursor yielding references to all documents, invalidated by any modification of collection
+    Cursor<MatchAll> getAllView() const { return Cursor<MatchAll>(&_documents.values(), MatchAll{}); }
+
+    /// @brief Execute query and describe plan chosen for it
+    /// @tparam Query Query expression
+    /// @param query Query expression built with field()
+    /// @return Chosen plan with estimated and actual number of scanned and returned documents
+    template<typename Query>
+    QueryPlan explain(Query&& query) const;
+
+    /// @brief Group matching documents and accumulate their fields, without copying documents
+    /// @tparam Filter Function or query expression
+    /// @param filter Function filtering documents, query expressions are served from indexes when possible
+    /// @param aggregation Grouping field and accumulated fields
+    /// @param execution Execution mode, partitions are accumulated concurrently and merged in order of matches,
+    /// which is collection order unless execution is Execution::ParallelUnordered
+    /// @return One document per group, in order of first appearance, unspecified order for Execution::ParallelUnordered
+    template<typename Filter>
+    std::vector<Document> aggregate(Filter&& filter, const Aggregation& aggregation,
+                                    Execution execution = Execution::Sequential) const;
+
+    /// @brief Find documents which top-level field is equal to value
+    /// @param field Name of field
+    /// @param value Value to compare with, numeric values are compared by value
+    /// @return Vector of copies of found documents, served from index if field is indexed
+    std::vector<Document> findEqual(const std::string& field, const Document::Value& value) const;
+
+    /// @brief Find documents which top-level field lies in range
+    /// @param field Name of field
+    /// @param lower Lower bound, std::nullopt if range is not bounded from below
+    /// @param upper Upper bound, std::nullopt if range is not bounded from above
+    /// @return Vector of copies of found documents ordered by field, served from ordered index if field is indexed
+    std::vector<Document> findRange(const std::string& field, const std::optional<Bound>& lower, const std::optional<Bound>& upper) const;
+
+    /// @brief Find documents which top-level string field starts with prefix
+    /// @param field Name of field
+    /// @param prefix Prefix to look for
+    /// @return Vector of copies of found documents ordered by field, served from ordered index if field is indexed
+    std::vector<Document> findPrefix(const std::string& field, const std::string& prefix) const;
+
+    /// @brief Create index over top-level field
+    /// @param field Name of field to be indexed
+    /// @param type Kind of index
+    void createIndex(const std::string& field, IndexType type = IndexType::Hash);
+
+    /// @brief Drop all indexes over field
+    /// @param field Name of indexed field
+    void dropIndex(const std::string& field);
+
+    /// @brief Check if field is indexed
+    /// @param field Name of field
+    /// @param type Kind of index
+    /// @return True if index over field exists, false otherwise
+    bool hasIndex(const std::string& field, IndexType type = IndexType::Hash) const;
+
+    /// @brief Get all indexes
+    /// @return Indexed fields and kinds of their indexes
+    std::vector<std::pair<std::string, IndexType>> getIndexes() const;
+
     /// @brief Remove documents
     /// @tparam Filter Function
     /// @param filter Function filtering which documents should be updated
@@ -42,7 +157,7 @@ public:
     template<typename Filter>
     std::vector<size_t> remove(Filter&& filter);
 
-    /// @brief Remove document
+    /// @brief Remove document in constant time, last document of collection takes its place in scan order
     /// @param doc Document
     void remove(Document& doc);
 
@@ -56,7 +171,7 @@ public:
 
     /// @brief Get all documents
     /// @return Copy of all documents
-    std::vector<Document> getAll() const { return _documents; }
+    std::vector<Document> getAll() const { return _documents.values(); }
 
     /// @brief Fil container with collection's unique ids
     /// @tparam Container Document::Map or Document::Vector
@@ -68,28 +183,136 @@ public:
     /// @return Copy of collection's name
     std::string getName() const { return _name; }
 
+    /// @brief Get strategy of generating ids
+    /// @return Id strategy
+    IdStrategy getIdStrategy() const { return _idGenerator.getStrategy(); }
+
+    /// @brief Get number of documents
+    /// @return Number of documents
+    size_t size() const { return _documents.size(); }
+
     /// @brief Get document by id
     /// @param id Document's id
     /// @return Document if one exists, std::nullopt otherwise
     std::optional<Document> getDocumentById(size_t id);
 
+    /// @brief Get handle of document, which stays valid until document is removed
+    /// @param id Document's id
+    /// @return Handle if document exists, std::nullopt otherwise
+    std::optional<SlotHandle> getHandle(size_t id) const;
+
+    /// @brief Get document by handle, without looking up its id
+    /// @param handle Handle of document
+    /// @return Pointer to document, nullptr if it was removed, invalidated by any modification of collection
+    const Document* getDocument(SlotHandle handle) const { return _documents.get(handle); }
+
 private:
     /// @brief Collection's name
     std::string _name;
 
-    /// @brief Documents in collection
-    std::vector<Document> _documents;
+    /// @brief Documents in collection, densely packed in insertion order until single document is removed and last one takes its place
+    SlotMap<Document> _documents;
 
     /// @brief Set of documents id
     std::unordered_set<size_t> _ids;
 
-    /// @brief Random number generator
-    std::mt19937_64 _rng{std::random_device{}()};
+    /// @brief Map of document id to its handle in _documents
+    std::unordered_map<size_t, SlotHandle> _handles;
+
+    /// @brief Map of field name to hash index over it
+    std::unordered_map<std::string, HashIndex> _hashIndexes;
+
+    /// @brief Map of field name to ordered index over it
+    std::unordered_map<std::string, OrderedIndex> _orderedIndexes;
+
+    /// @brief Generator of document ids
+    IdGenerator _idGenerator;
 
     /// @brief Generate unique id
     /// @return Id
     size_t generateId();
 
+    /// @brief Assign ids to document and its nested documents, reserving document's id
+    /// @param doc Document to be inserted
+    /// @return Id of document, std::nullopt if document with the same id already exists
+    std::optional<size_t> prepareInsert(Document& doc);
+
+    /// @brief Place prepared document in collection and its indexes
+    /// @param doc Document with assigned ids
+    /// @param id Document's id
+    /// @return Handle of stored document
+    SlotHandle store(Document&& doc, size_t id);
+
+    /// @brief Copy documents of handles returned by ordered index, documents with equal key in collection order
+    /// @param handles Handles of documents ordered by key
+    /// @param field Indexed field
+    /// @return Vector of copies of documents
+    std::vector<Document> collectDocuments(const std::vector<SlotHandle>& handles, const std::string& field) const;
+
+    /// @brief Add document to all indexes
+    /// @param doc Document to be indexed
+    /// @param handle Handle of document
+    void indexDocument(const Document& doc, SlotHandle handle);
+
+    /// @brief Remove document from all indexes
+    /// @param doc Document as it was indexed
+    /// @param handle Handle of document
+    void unindexDocument(const Document& doc, SlotHandle handle);
+
+    /// @brief Fraction of collection above which index lookup is replaced with full scan
+    static constexpr double scanThreshold{0.3};
+
+    /// @brief Index lookup is intersected with candidates if it is at most this many times larger
+    static constexpr size_t intersectFactor{4};
+
+    /// @brief Minimal number of documents in one partition of parallel scan
+    static constexpr size_t minPartitionSize{4096};
+
+    /// @brief Find positions of documents matching filter, query expressions are planned and served from indexes when possible
+    /// @tparam Filter Function or query expression
+    /// @param filter Function filtering documents
+    /// @param execution Execution mode of full scans
+    /// @param plan If not nullptr, filled with executed plan
+    /// @return Positions in _documents, ascending unless execution is Execution::ParallelUnordered
+    template<typename Filter>
+    std::vector<size_t> matchPositions(Filter& filter, Execution execution = Execution::Sequential, QueryPlan* plan = nullptr) const;
+
+    /// @brief Scan all documents
+    /// @tparam Test Function of format: bool **Test**(const Document&)
+    /// @param test Function testing documents
+    /// @param execution Execution mode
+    /// @return Positions of documents passing test
+    template<typename Test>
+    std::vector<size_t> scanPositions(const Test& test, Execution execution) const;
+
+    /// @brief Get number of partitions for parallel processing
+    /// @param count Number of processed elements
+    /// @return Number of partitions, 1 if processing should stay sequential
+    static size_t partitionCount(size_t count);
+
+    /// @brief Compare documents by sort key
+    /// @param lhs First document
+    /// @param rhs Second document
+    /// @param key Sort key
+    /// @return Negative if lhs goes before rhs, zero if equal, positive otherwise
+    static int compareSortKeys(const Document& lhs, const Document& rhs, const SortKey& key);
+
+    /// @brief Choose access paths and order of residual predicates
+    /// @param predicates Predicates which all must hold
+    /// @param complete True if predicates describe whole query
+    /// @return Plan of query
+    QueryPlan planQuery(std::vector<Predicate> predicates, bool complete) const;
+
+    /// @brief Estimate number of documents matching single predicate
+    /// @param predicate Predicate to estimate
+    /// @return Estimated number of documents
+    size_t estimateMatches(const Predicate& predicate) const;
+
+    /// @brief Find candidate positions by intersecting access paths of plan
+    /// @param plan Plan which is not full scan
+    /// @return Ascending positions of candidates
+    std::vector<size_t> candidatePositions(const QueryPlan& plan) const;
+
     /// @brief Fill document with unique ids
     /// @param document Document which nested documents to be filled
     void fillDocumentWithIds(Document& document);
@@ -118,19 +341,21 @@ std::vector<size_t> Collection::update(Filter&& filter, Modifier&& modify) {
 
     std::vector<size_t> idsUpdated;
 
-    for(size_t pos{0}; pos < _documents.size(); ++pos) {
+    for(size_t pos : matchPositions(filter)) {
         auto& doc = _documents[pos];
+        auto handle = _documents.handleAt(pos);
 
-        if(filter(doc)) {
-            modify(doc);
+        auto idOpt = doc.get<size_t>("id");
+        unindexDocument(doc, handle);
 
-            auto idOpt = doc.get<size_t>("id");
-            if (idOpt) {
-                idsUpdated.push_back(*idOpt);
-                Logger::logInfo("Modified document of id: " + std::to_string(static_cast<size_t>(*idOpt)) + " in collection: " + _name + ".");
-            } else {
-                Logger::logWarning("Modified document with no id in collection: " + _name + ".");
-            }
+        modify(doc);
+
+        indexDocument(doc, handle);
+        if (idOpt) {
+            idsUpdated.push_back(*idOpt);
+            Logger::logInfo("Modified document of id: " + std::to_string(static_cast<size_t>(*idOpt)) + " in collection: " + _name + ".");
+        } else {
+            Logger::logWarning("Modified document with no id in collection: " + _name + ".");
         }
     }
 
@@ -141,47 +366,294 @@ template<typename Filter>
 std::vector<Document> Collection::find(Filter&& filter) {
     assert_filter<Filter>();
 
+    auto positions = matchPositions(filter);
+
     std::vector<Document> results;
-    for(const auto& doc : _documents) {
-        if(filter(doc)) {
-            results.push_back(doc);
+    results.reserve(positions.size());
+    for(auto pos : positions) {
+        results.push_back(_documents[pos]);
+    }
+
+    return results;
+}
+
+template<typename Filter>
+std::vector<Document> Collection::find(Filter&& filter, Execution execution) {
+    assert_filter<Filter>();
+
+    auto positions = matchPositions(filter, execution);
+    std::vector<Document> results(positions.size());
+
+    size_t partitions = partitionCount(positions.size());
+    if(execution == Execution::Sequential || partitions == 1) {
+        for(size_t i{0}; i < positions.size(); ++i) {
+            results[i] = _documents[positions[i]];
         }
+
+        return results;
     }
 
+    ThreadPool::shared().parallelFor(positions.size(), partitions, [&](size_t, size_t begin, size_t end) {
+        for(size_t i{begin}; i < end; ++i) {
+            results[i] = _documents[positions[i]];
+        }
+    });
+
     return results;
 }
 
 template<typename Filter>
-std::vector<size_t> Collection::remove(Filter&& filter) {
+std::vector<Document> Collection::find(Filter&& filter, const FindOptions& options) {
     assert_filter<Filter>();
 
-    std::vector<size_t> toRemove;
-    for(size_t i{0}; i < _documents.size(); ++i) {
-        if(filter(_documents[i])) {
-            toRemove.push_back(i);
+    std::vector<Document> results;
+    if(options.limit && *options.limit == 0) {
+        return results;
+    }
+
+    auto materialize = [&options, &results](const Document& doc) {
+        results.push_back(options.projection ? options.projection->apply(doc) : doc);
+    };
+
+    auto view = findView(std::forward<Filter>(filter));
+    if(!options.sort) {
+        size_t skipped{0};
+        for(const auto& doc : view) {
+            if(skipped < options.skip) {
+                ++skipped;
+                continue;
+            }
+
+            materialize(doc);
+            if(options.limit && results.size() == *options.limit) {
+                break;
+            }
+        }
+
+        return results;
+    }
+
+    // Matches are ranked by sort key, then by collection order
+    using Ranked = std::pair<const Document*, size_t>;
+    const auto& key = *options.sort;
+    auto before = [&key](const Ranked& lhs, const Ranked& rhs) {
+        int result = compareSortKeys(*lhs.first, *rhs.first, key);
+        return result != 0 ? result < 0 : lhs.second < rhs.second;
+    };
+
+    std::optional<size_t> kept;
+    if(options.limit) {
+        kept = *options.limit > std::numeric_limits<size_t>::max() - options.skip
+            ? std::numeric_limits<size_t>::max()
+            : options.skip + *options.limit;
+    }
+
+    // With limit, ranked is max-heap holding best matches seen so far, its top is the worst of them
+    std::vector<Ranked> ranked;
+    size_t sequence{0};
+    for(const auto& doc : view) {
+        ranked.emplace_back(&doc, sequence++);
+        if(kept) {
+            std::push_heap(ranked.begin(), ranked.end(), before);
+            if(ranked.size() > *kept) {
+                std::pop_heap(ranked.begin(), ranked.end(), before);
+                ranked.pop_back();
+            }
         }
     }
 
+    std::sort(ranked.begin(), ranked.end(), before);
+
+    if(ranked.size() > options.skip) {
+        results.reserve(ranked.size() - options.skip);
+    }
+    for(size_t i{options.skip}; i < ranked.size(); ++i) {
+        materialize(*ranked[i].first);
+    }
+
+    return results;
+}
+
+template<typename Filter>
+std::vector<Document> Collection::find(Filter&& filter, const Projection& projection) {
+    assert_filter<Filter>();
+
+    auto positions = matchPositions(filter);
+
+    std::vector<Document> results;
+    results.reserve(positions.size());
+    for(auto pos : positions) {
+        results.push_back(projection.apply(_documents[pos]));
+    }
+
+    return results;
+}
+
+template<typename Filter>
+std::vector<size_t> Collection::remove(Filter&& filter) {
+    assert_filter<Filter>();
+
+    auto toRemove = matchPositions(filter);
+
     std::vector<size_t> docIds;
 
     if(toRemove.empty()) {
         Logger::logWarning("Tried to remove non existing document in collection" + _name + ".");
+        return docIds;
     }
 
-    for(auto it = toRemove.rbegin(); it != toRemove.rend(); ++it) {
-        size_t i{*it};
-        auto id = _documents[i].get<size_t>("id").value_or(0);
+    docIds.reserve(toRemove.size());
+    for(size_t pos : toRemove) {
+        auto id = _documents[pos].get<size_t>("id").value_or(0);
         docIds.push_back(id);
 
         _ids.erase(id);
-
-        _documents.erase(_documents.begin() + i);
-        Logger::logInfo("Removed document of id: " + std::to_string(id) + "in collection: " + _name + ".");
+        _handles.erase(id);
+        unindexDocument(_documents[pos], _documents.handleAt(pos));
     }
 
+    _documents.erasePositions(toRemove);
+    Logger::logInfo("Removed " + std::to_string(docIds.size()) + " document(s) in collection: " + _name + ".");
+
     return docIds;
 }
 
+template<typename Filter>
+Cursor<std::decay_t<Filter>> Collection::findView(Filter&& filter) const {
+    assert_filter<Filter>();
+
+    if constexpr(is_query_v<Filter>) {
+        std::vector<Predicate> predicates;
+        bool complete = filter.collectConjuncts(predicates);
+        auto plan = planQuery(std::move(predicates), complete);
+
+        if(!plan.isFullScan()) {
+            return Cursor<std::decay_t<Filter>>(&_documents.values(), std::forward<Filter>(filter), candidatePositions(plan));
+        }
+    }
+
+    return Cursor<std::decay_t<Filter>>(&_documents.values(), std::forward<Filter>(filter));
+}
+
+template<typename Query>
+QueryPlan Collection::explain(Query&& query) const {
+    static_assert(is_query_v<Query>, "Only query expressions built with field() can be explained");
+
+    QueryPlan plan;
+    matchPositions(query, Execution::Sequential, &plan);
+    return plan;
+}
+
+template<typename Filter>
+std::vector<Document> Collection::aggregate(Filter&& filter, const Aggregation& aggregation, Execution execution) const {
+    assert_filter<Filter>();
+
+    auto positions = matchPositions(filter, execution);
+
+    size_t partitions = partitionCount(positions.size());
+    if(execution == Execution::Sequential || partitions == 1) {
+        AggregationState state(aggregation);
+        for(auto pos : positions) {
+            state.add(_documents[pos]);
+        }
+
+        return state.results();
+    }
+
+    std::vector<AggregationState> states(partitions, AggregationState(aggregation));
+    ThreadPool::shared().parallelFor(positions.size(), partitions, [&](size_t chunk, size_t begin, size_t end) {
+        for(size_t i{begin}; i < end; ++i) {
+            states[chunk].add(_documents[positions[i]]);
+        }
+    });
+
+    for(size_t chunk{1}; chunk < partitions; ++chunk) {
+        states.front().merge(states[chunk]);
+    }
+
+    return states.front().results();
+}
+
+template<typename Filter>
+std::vector<size_t> Collection::matchPositions(Filter& filter, Execution execution, QueryPlan* plan) const {
+    std::vector<size_t> positions;
+
+    if constexpr(is_query_v<Filter>) {
+        std::vector<Predicate> predicates;
+        bool complete = filter.collectConjuncts(predicates);
+        auto queryPlan = planQuery(std::move(predicates), complete);
+
+        auto matches = [&](const Document& doc) {
+            return queryPlan.matchesResidual(doc) && (queryPlan.complete || filter(doc));
+        };
+
+        if(queryPlan.isFullScan()) {
+            positions = scanPositions(matches, execution);
+            queryPlan.scanned = _documents.size();
+        }
+        else {
+            auto candidates = candidatePositions(queryPlan);
+            for(auto pos : candidates) {
+                if(matches(_documents[pos])) {
+                    positions.push_back(pos);
+                }
+            }
+            queryPlan.scanned = candidates.size();
+        }
+
+        queryPlan.returned = positions.size();
+        if(plan) {
+            *plan = std::move(queryPlan);
+        }
+
+        return positions;
+    }
+    else {
+        return scanPositions(filter, execution);
+    }
+}
+
+template<typename Test>
+std::vector<size_t> Collection::scanPositions(const Test& test, Execution execution) const {
+    std::vector<size_t> positions;
+
+    size_t partitions = partitionCount(_documents.size());
+    if(execution == Execution::Sequential || partitions == 1) {
+        for(size_t pos{0}; pos < _documents.size(); ++pos) {
+            if(test(_documents[pos])) {
+                positions.push_back(pos);
+            }
+        }
+
+        return positions;
+    }
+
+    std::vector<std::vector<size_t>> partial(partitions);
+    std::mutex mutex;
+
+    ThreadPool::shared().parallelFor(_documents.size(), partitions, [&](size_t partition, size_t begin, size_t end) {
+        auto& local = partial[partition];
+        for(size_t pos{begin}; pos < end; ++pos) {
+            if(test(_documents[pos])) {
+                local.push_back(pos);
+            }
+        }
+
+        if(execution == Execution::ParallelUnordered) {
+            std::lock_guard<std::mutex> lock(mutex);
+            positions.insert(positions.end(), local.begin(), local.end());
+        }
+    });
+
+    if(execution == Execution::Parallel) {
+        for(const auto& local : partial) {
+            positions.insert(positions.end(), local.begin(), local.end());
+        }
+    }
+
+    return positions;
+}
+
 template<typename Container>
 void Collection::insertContainerToDocument(Container& container, std::string name, Document& doc) {
     auto idOpt = doc.get<size_t>("id");
@@ -202,18 +674,21 @@ void Collection::insertContainerToDocument(Container& container, std::string nam
         return;
     }
 
-    auto it = std::find_if(_documents.begin(), _documents.end(), [&](const Document& d) {
-        auto existingId = d.get<size_t>("id");
-        return existingId && *existingId == id;
-    });
+    auto handle = getHandle(id);
 
-    if(it != _documents.end()) {
-        *it = doc;
+    if(handle) {
+        auto& stored = *_documents.get(*handle);
+        unindexDocument(stored, *handle);
+        stored = doc;
+        indexDocument(stored, *handle);
         Logger::logInfo("Updated existing document with id: " + std::to_string(id) + " in collection: " + _name + ".");
     } 
     else {
-        _documents.push_back(doc);
+        auto inserted = _documents.insert(doc);
+        _handles.emplace(id, inserted);
         _ids.insert(id);
+        _idGenerator.observe(id);
+        indexDocument(doc, inserted);
         Logger::logInfo("Inserted new document with id: " + std::to_string(id) + " in collection: " + _name + ".");
     }
 }
@@ -232,7 +707,7 @@ void Collection::fillContainerWithIds(Container& container) {
                 doc.set("id", id);
             }
         }
-        catch(std::runtime_error e) {
+        catch(const std::runtime_error& e) {
             Logger::logError("Failed to add Document::Vector to collection " + _name + ": " + e.what());
             return;
         }
@@ -248,7 +723,7 @@ void Collection::fillContainerWithIds(Container& container) {
                 doc.set("id", id);
             }
         }
-        catch(std::runtime_error e) {
+        catch(const std::runtime_error& e) {
             Logger::logError("Failed to add Document::Map to collection " + _name + ": " + e.what());
             return;
         }
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "SegmentStore.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief Options of background compaction of segment stores
+struct CompactionOptions {
+    /// @brief True to compact in background thread
+    bool enabled{false};
+
+    /// @brief Minimal part of segment taken by superseded records and tombstones to rewrite it
+    double deadRatio{0.5};
+
+    /// @brief Limit of bytes read and written by compaction per second, 0 for no limit
+    uint64_t bytesPerSecond{0};
+
+    /// @brief Time between compaction passes
+    std::chrono::milliseconds interval{1000};
+};
+
+/// @brief Periodically compacts tracked segment stores in background thread
+class Compactor {
+public:
+    /// @brief Construct a compactor, background thread is started if options enable it
+    /// @param options Options of compaction
+    explicit Compactor(CompactionOptions options);
+
+    /// @brief Stop background thread, waiting for running pass to finish
+    ~Compactor();
+
+    Compactor(const Compactor&) = delete;
+    Compactor& operator=(const Compactor&) = delete;
+
+    /// @brief Start compacting store, it is dropped once no one else owns it
+    /// @param store Segment store
+    void track(const std::shared_ptr<SegmentStore>& store);
+
+    /// @brief Compact all tracked stores on calling thread
+    /// @return Number of rewritten segments
+    size_t compact();
+
+    /// @brief Get options of compaction
+    /// @return Options
+    const CompactionOptions& getOptions() const { return _options; }
+
+private:
+    /// @brief Options of compaction
+    CompactionOptions _options;
+
+    /// @brief Tracked stores
+    std::vector<std::weak_ptr<SegmentStore>> _stores;
+
+    /// @brief Mutex guarding tracked stores and stopping flag
+    std::mutex _mutex;
+
+    /// @brief Signals stopping
+    std::condition_variable _stop;
+
+    /// @brief True if compactor is being destroyed
+    bool _stopping{false};
+
+    /// @brief Background thread, not started if compaction is disabled
+    std::thread _thread;
+
+    /// @brief Loop of background thread
+    void run();
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Document.hpp"
+
+#include <iterator>
+#include <optional>
+#include <vector>
+
+/// @brief Filter accepting every document
+struct MatchAll {
+    bool operator()(const Document&) const { return true; }
+};
+
+/// @brief Lazy range of documents matching filter, yielding references instead of copies
+/// @details Cursor and its iterators are invalidated by any insert, update or remove in the collection which created it,
+/// and must not outlive it. Filter is evaluated while iterating, so a cursor may be iterated more than once.
+/// @tparam Filter Function of format: bool **Filter**(const Document&)
+template<typename Filter>
+class Cursor {
+public:
+    /// @brief Forward iterator over matching documents
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Document;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Document*;
+        using reference = const Document&;
+
+        /// @brief Construct an iterator
+        /// @param cursor Iterated cursor
+        /// @param index Index of first element to be checked
+        Iterator(const Cursor* cursor, size_t index) : _cursor(cursor), _index(index) { skip(); }
+
+        reference operator*() const { return _cursor->at(_index); }
+        pointer operator->() const { return &_cursor->at(_index); }
+
+        Iterator& operator++() {
+            ++_index;
+            skip();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator copy(*this);
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) { return lhs._index == rhs._index; }
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) { return !(lhs == rhs); }
+
+    private:
+        /// @brief Iterated cursor
+        const Cursor* _cursor;
+
+        /// @brief Index of current element
+        size_t _index;
+
+        /// @brief Move forward to first matching document
+        void skip() {
+            while(_index < _cursor->count() && !_cursor->_filter(_cursor->at(_index))) {
+                ++_index;
+            }
+        }
+    };
+
+    /// @brief Construct a cursor
+    /// @param documents Documents to iterate, nullptr for empty cursor
+    /// @param filter Function filtering documents
+    /// @param candidates Positions of documents to be checked, std::nullopt to check all of them
+    Cursor(const std::vector<Document>* documents, Filter filter, std::optional<std::vector<size_t>> candidates = std::nullopt)
+        : _documents(documents), _filter(std::move(filter)), _candidates(std::move(candidates)) {}
+
+    /// @brief Get iterator to first matching document
+    Iterator begin() const { return Iterator(this, 0); }
+
+    /// @brief Get iterator past last document
+    Iterator end() const { return Iterator(this, count()); }
+
+    /// @brief Check if no document matches
+    /// @return True if cursor yields nothing, false otherwise
+    bool empty() const { return begin() == end(); }
+
+private:
+    /// @brief Iterated documents
+    const std::vector<Document>* _documents;
+
+    /// @brief Function filtering documents
+    Filter _filter;
+
+    /// @brief Positions of documents to be checked, std::nullopt if all of them are checked
+    std::optional<std::vector<size_t>> _candidates;
+
+    /// @brief Get number of documents to be checked
+    size_t count() const {
+        if(!_documents) {
+            return 0;
+        }
+        return _candidates ? _candidates->size() : _documents->size();
+    }
+
+    /// @brief Get document to be checked
+    /// @param index Index of document among checked ones
+    const Document& at(size_t index) const { return (*_documents)[_candidates ? (*_candidates)[index] : index]; }
+};
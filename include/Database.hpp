@@ -1,18 +1,85 @@
+#pragma once
+
 #include "Collection.hpp"
+#include "Snapshot.hpp"
 #include "Storage.hpp"
+#include "WriteAheadLog.hpp"
+
+#include <memory>
+#include <unordered_set>
+
+/// @brief Options of opened database
+struct DatabaseOptions {
+    /// @brief Strategy of generating ids in loaded and added collections
+    IdStrategy idStrategy{IdStrategy::Random};
+
+    /// @brief Format of saved documents, documents of all formats are always loaded
+    StorageFormat storageFormat{StorageFormat::Text};
+
+    /// @brief Compaction of collections stored in StorageFormat::Segment
+    CompactionOptions compaction{};
+
+    /// @brief Write-ahead log of mutations, document files are updated at checkpoints when enabled
+    WalOptions wal{};
+
+    /// @brief True to write binary snapshot of collections at checkpoints, existing snapshots are always loaded
+    bool snapshots{false};
+
+    /// @brief How collections and their document files are loaded when database is opened
+    Execution loading{Execution::Parallel};
+
+    /// @brief True to only discover names of collections when database is opened and load each on first access
+    bool lazyLoading{false};
+
+    /// @brief Number of loaded collections beyond which least recently used ones without unsaved mutations are
+    /// unloaded when other collection is loaded, 0 to never unload them
+    size_t maxLoadedCollections{0};
+};
 
 /// @brief Represents a database containing named collections
 class Database {
 public:
     /// @brief Construct a database
     /// @param name Path of the database
-    Database(std::string path);
+    /// @param options Options of database
+    Database(std::string path, DatabaseOptions options = {});
+
+    /// @brief Construct a database
+    /// @param name Path of the database
+    /// @param idStrategy Strategy of generating ids in loaded and added collections
+    Database(std::string path, IdStrategy idStrategy) : Database(std::move(path), DatabaseOptions{idStrategy}) {}
+
+    /// @brief Take checkpoint, so logged mutations are saved in document files
+    ~Database();
+
+    /// @brief Save documents mutated since last checkpoint in document files and snapshots if enabled, then drop
+    /// write-ahead log records
+    void checkpoint();
+
+    /// @brief Rewrite files of all collections in given format and save documents in it from now on
+    /// @param format Target storage format
+    void convertStorage(StorageFormat format);
+
+    /// @brief Rewrite segments of all collections which have enough dead records, on calling thread
+    /// @return Number of rewritten segments
+    size_t compactStorage() { return _storage.compact(); }
     
     /// @brief Get mutable reference to collection
     /// @param collectionName Name of collection
     /// @return Optional reference to collection if it exists
     std::optional<std::reference_wrapper<Collection>> getCollection(std::string collectionName);
 
+    /// @brief Check if documents of collection are in memory
+    /// @param collectionName Name of collection
+    /// @return True if collection exists and is loaded
+    bool isLoaded(const std::string& collectionName) const;
+
+    /// @brief Drop documents of collection from memory, they are loaded again on next access
+    /// @details Collection handed out by getCollection stays loaded, so references obtained from it never dangle
+    /// @param collectionName Name of collection
+    /// @return True if collection was unloaded, false if it is not loaded, was handed out by getCollection or has mutations not yet checkpointed
+    bool unloadCollection(const std::string& collectionName);
+
     /// @brief Get copy of collection if exists
     /// @param collectionName Name of collection
     /// @return Optional collection copy if exists
@@ -30,6 +97,12 @@ public:
     /// @param collectionName Name of collection
     /// @param doc Document to insert
     void insert(std::string collectionName, Document doc);
+
+    /// @brief Insert many documents into collection and persist them in one batch
+    /// @param collectionName Name of collection
+    /// @param docs Documents to insert, moved into collection
+    /// @return Ids of inserted documents, empty if collection does not exist
+    std::vector<size_t> insertMany(std::string collectionName, std::vector<Document> docs);
     
     /// @brief Update documents in collection matching filter
     /// @tparam Filter Function
@@ -47,7 +120,87 @@ public:
     /// @return Vector of copies of matching documents
     template<typename Filter>
     std::vector<Document> find(std::string collectionName, Filter&& filter);
+
+    /// @brief Find documents in collection matching filter, scanning partitions concurrently
+    /// @tparam Filter Function, must be safe to call concurrently
+    /// @param collectionName Name of collection
+    /// @param filter Function filtering documents
+    /// @param execution Execution mode
+    /// @return Vector of copies of matching documents
+    template<typename Filter>
+    std::vector<Document> find(std::string collectionName, Filter&& filter, Execution execution);
+
+    /// @brief Find documents in collection matching filter, materializing only projected parts of them
+    /// @tparam Filter Function or query expression
+    /// @param collectionName Name of collection
+    /// @param filter Function filtering documents
+    /// @param projection Fields to be kept or dropped
+    /// @return Vector of projected copies of matching documents
+    template<typename Filter>
+    std::vector<Document> find(std::string collectionName, Filter&& filter, const Projection& projection);
+
+    /// @brief Find documents in collection matching filter, stopping early once limit is reached
+    /// @tparam Filter Function or query expression
+    /// @param collectionName Name of collection
+    /// @param filter Function filtering documents
+    /// @param options Skip, limit, sort and projection of results
+    /// @return Vector of copies of matching documents
+    template<typename Filter>
+    std::vector<Document> find(std::string collectionName, Filter&& filter, const FindOptions& options);
     
+    /// @brief Find documents in collection lazily, without copying them
+    /// @tparam Filter Function or query expression
+    /// @param collectionName Name of collection
+    /// @param filter Function filtering documents
+    /// @return Cursor yielding references to matching documents, empty if collection does not exist
+    template<typename Filter>
+    Cursor<std::decay_t<Filter>> findView(std::string collectionName, Filter&& filter) const;
+
+    /// @brief Get all documents from collection lazily, without copying them
+    /// @param collectionName Name of collection
+    /// @return Cursor yielding references to all documents, empty if collection does not exist
+    Cursor<MatchAll> getAllView(std::string collectionName) const;
+
+    /// @brief Execute query in collection and describe plan chosen for it
+    /// @tparam Query Query expression
+    /// @param collectionName Name of collection
+    /// @param query Query expression built with field()
+    /// @return Chosen plan with statistics, std::nullopt if collection does not exist
+    template<typename Query>
+    std::optional<QueryPlan> explain(std::string collectionName, Query&& query) const;
+
+    /// @brief Group matching documents of collection and accumulate their fields
+    /// @tparam Filter Function or query expression
+    /// @param collectionName Name of collection
+    /// @param filter Function filtering documents
+    /// @param aggregation Grouping field and accumulated fields
+    /// @param execution Execution mode
+    /// @return One document per group, empty if collection does not exist
+    template<typename Filter>
+    std::vector<Document> aggregate(std::string collectionName, Filter&& filter, const Aggregation& aggregation,
+                                    Execution execution = Execution::Sequential) const;
+
+    /// @brief Find documents in collection which top-level field is equal to value
+    /// @param collectionName Name of collection
+    /// @param field Name of field
+    /// @param value Value to compare with
+    /// @return Vector of copies of matching documents
+    std::vector<Document> findEqual(std::string collectionName, const std::string& field, const Document::Value& value) const;
+
+    /// @brief Find documents in collection which top-level field lies in range
+    /// @param collectionName Name of collection
+    /// @param field Name of field
+    /// @param lower Lower bound, std::nullopt if range is not bounded from below
+    /// @param upper Upper bound, std::nullopt if range is not bounded from above
+    /// @return Vector of copies of matching documents ordered by field
+    std::vector<Document> findRange(std::string collectionName, const std::string& field, const std::optional<Bound>& lower, const std::optional<Bound>& upper) const;
+
+    /// @brief Create index over top-level field of collection
+    /// @param collectionName Name of collection
+    /// @param field Name of field to be indexed
+    /// @param type Kind of index
+    void createIndex(std::string collectionName, const std::string& field, IndexType type = IndexType::Hash);
+
     /// @brief Remove documents in collection matching filter
     /// @tparam Filter Function
     /// @param collectionName Name of collection
@@ -76,7 +229,7 @@ public:
     
     /// @brief Check id database is empty
     /// @return Returns true if there is no collections, false otherwise
-    bool empty() const { return _collections.empty(); }
+    bool empty() const { return _collections.empty() && _unloaded.empty(); }
 
     std::string getName() const { return _name; }
     
@@ -86,12 +239,79 @@ private:
 
     /// @brief Database name
     std::string _name;
+
+    /// @brief Options of database
+    DatabaseOptions _options;
     
-    /// @brief Map of collection names to collections
-    std::unordered_map<std::string, Collection> _collections;
+    /// @brief Map of collection names to loaded collections, filled on access by const members too
+    mutable std::unordered_map<std::string, Collection> _collections;
+
+    /// @brief Names of existing collections which documents are not loaded
+    mutable std::unordered_set<std::string> _unloaded;
+
+    /// @brief Counter of accesses to collections, tracked only when loaded collections are limited
+    mutable uint64_t _accessClock{0};
+
+    /// @brief Value of access counter at last access of each loaded collection
+    mutable std::unordered_map<std::string, uint64_t> _lastAccess;
     
     /// @brief Object responsible for storing data
-    Storage _storage;
+    mutable Storage _storage;
+
+    /// @brief Log of mutations since last checkpoint, nullptr if disabled
+    std::unique_ptr<WriteAheadLog> _wal;
+
+    /// @brief Ids of documents mutated since last checkpoint by collection name
+    std::unordered_map<std::string, std::unordered_set<size_t>> _dirty;
+
+    /// @brief Names of loaded collections handed out by getCollection, which may hold mutations not persisted
+    mutable std::unordered_set<std::string> _exposed;
+
+    /// @brief LSN covered by valid snapshot by loaded collection name
+    mutable std::unordered_map<std::string, uint64_t> _snapshotLsns;
+
+    /// @brief Load collection from its snapshot, or from document files if it has no valid snapshot
+    /// @details Touches no state of database other than storage, so collections may be loaded concurrently
+    /// @param collection Empty collection
+    /// @param collectionPath Collection's directory
+    /// @return LSN covered by loaded snapshot, std::nullopt if loaded from document files
+    std::optional<uint64_t> loadCollection(Collection& collection, const std::filesystem::path& collectionPath) const;
+
+    /// @brief Find collection, loading its documents first if they are not in memory
+    /// @param collectionName Name of collection
+    /// @return Pointer to collection, nullptr if it does not exist
+    const Collection* findCollection(const std::string& collectionName) const;
+
+    /// @brief Find collection, loading its documents first if they are not in memory
+    /// @param collectionName Name of collection
+    /// @return Pointer to collection, nullptr if it does not exist
+    Collection* findCollection(const std::string& collectionName);
+
+    /// @brief Drop documents of loaded collection neither handed out by getCollection nor with mutations waiting for checkpoint
+    /// @param collectionName Name of collection
+    /// @return True if collection was unloaded
+    bool releaseCollection(const std::string& collectionName) const;
+
+    /// @brief Unload least recently used collections until their number fits limit
+    /// @param accessedName Name of collection being accessed, which is never unloaded
+    void releaseIdleCollections(const std::string& accessedName) const;
+
+    /// @brief Remove snapshot of collection, once document files were changed behind it
+    /// @param collectionName Name of collection
+    void invalidateSnapshot(const std::string& collectionName);
+
+    /// @brief Open write-ahead log and replay its records, left after crash
+    void recover();
+
+    /// @brief Persist saved documents, in write-ahead log if enabled or in document files otherwise
+    /// @param collectionName Name of collection
+    /// @param docs Documents with ids
+    void persist(const std::string& collectionName, const std::vector<const Document*>& docs);
+
+    /// @brief Persist removal of documents, in write-ahead log if enabled or in document files otherwise
+    /// @param collectionName Name of collection
+    /// @param ids Ids of removed documents
+    void persistRemoval(const std::string& collectionName, const std::vector<size_t>& ids);
 
     /// @brief Ensure a directory exists on filesystem
     /// @param path Path to check
@@ -106,75 +326,134 @@ private:
 
 template<typename Filter, typename Modifier>
 void Database::update(std::string collectionName, Filter&& filter, Modifier&& modify) {
-    auto it = _collections.find(collectionName);
-    if(it == _collections.end()) {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
         Logger::logWarning("Tried to update documents in non exisitng collection of name: " + collectionName);
         return;
     }
 
-    auto& collection = it->second;
-    auto idsUpdated = collection.update(std::forward<Filter>(filter), std::forward<Modifier>(modify));
+    auto idsUpdated = collection->update(std::forward<Filter>(filter), std::forward<Modifier>(modify));
 
-    std::string path = _path + '/' + collectionName;
+    std::vector<const Document*> updated;
+    updated.reserve(idsUpdated.size());
     for(const auto& id : idsUpdated) {
-        auto docOpt = collection.getDocumentById(id);
-        if(docOpt) {
-            _storage.saveDocument(path, *docOpt);
+        if(auto handle = collection->getHandle(id)) {
+            updated.push_back(collection->getDocument(*handle));
         }
     }
+
+    persist(collectionName, updated);
 }
 
 template<typename Filter>
 std::vector<Document> Database::find(std::string collectionName, Filter&& filter) {
-    auto it = _collections.find(collectionName);
-    if(it == _collections.end()) {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
+        Logger::logWarning("Tried to find documents in non exisitng collection of name: " + collectionName);
+        return std::vector<Document>();
+    }
+
+    return collection->find(std::forward<Filter>(filter));
+}
+
+template<typename Filter>
+std::vector<Document> Database::find(std::string collectionName, Filter&& filter, Execution execution) {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
+        Logger::logWarning("Tried to find documents in non exisitng collection of name: " + collectionName);
+        return std::vector<Document>();
+    }
+
+    return collection->find(std::forward<Filter>(filter), execution);
+}
+
+template<typename Filter>
+std::vector<Document> Database::find(std::string collectionName, Filter&& filter, const Projection& projection) {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
+        Logger::logWarning("Tried to find documents in non exisitng collection of name: " + collectionName);
+        return std::vector<Document>();
+    }
+
+    return collection->find(std::forward<Filter>(filter), projection);
+}
+
+template<typename Filter>
+std::vector<Document> Database::find(std::string collectionName, Filter&& filter, const FindOptions& options) {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
+        Logger::logWarning("Tried to find documents in non exisitng collection of name: " + collectionName);
+        return std::vector<Document>();
+    }
+
+    return collection->find(std::forward<Filter>(filter), options);
+}
+
+template<typename Filter>
+Cursor<std::decay_t<Filter>> Database::findView(std::string collectionName, Filter&& filter) const {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
         Logger::logWarning("Tried to find documents in non exisitng collection of name: " + collectionName);
+        return Cursor<std::decay_t<Filter>>(nullptr, std::forward<Filter>(filter));
+    }
+
+    return collection->findView(std::forward<Filter>(filter));
+}
+
+template<typename Query>
+std::optional<QueryPlan> Database::explain(std::string collectionName, Query&& query) const {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
+        Logger::logWarning("Tried to explain query in non exisitng collection of name: " + collectionName);
+        return std::nullopt;
+    }
+
+    return collection->explain(std::forward<Query>(query));
+}
+
+template<typename Filter>
+std::vector<Document> Database::aggregate(std::string collectionName, Filter&& filter, const Aggregation& aggregation,
+                                          Execution execution) const {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
+        Logger::logWarning("Tried to aggregate documents in non exisitng collection of name: " + collectionName);
         return std::vector<Document>();
     }
 
-    auto& collection = it->second;
-    return collection.find(std::forward<Filter>(filter));
+    return collection->aggregate(std::forward<Filter>(filter), aggregation, execution);
 }
 
 template<typename Filter>
 void Database::remove(std::string collectionName, Filter&& filter) {
-    auto it = _collections.find(collectionName);
-    if(it == _collections.end()) {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
         Logger::logWarning("Tried to remove documents in non exisitng collection of name: " + collectionName);
         return;
     }
 
-    auto& collection = it->second;
+    auto docIds = collection->remove(std::forward<Filter>(filter));
 
-    auto docIds = collection.remove(std::forward<Filter>(filter));
-
-    std::string path = _path + '/' + collectionName;
-    for(const auto id : docIds) {
-        _storage.removeDocument(path, id);
-    }
+    persistRemoval(collectionName, docIds);
 }
 
 template<typename Container>
 void Database::insertContainerToDocument(std::string collectionName, Container& container, std::string name, Document& doc) {
-    auto it = _collections.find(collectionName);
-    if(it == _collections.end()) {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
         Logger::logWarning(collectionName + " does not exisst.");
         return;
     }
 
-    auto& collection = it->second;
-
-    collection.fillContainerWithIds(container);
+    collection->fillContainerWithIds(container);
 
     doc.set(name, container);
-    std::string path = _path + '/' + collectionName;
-    _storage.saveDocument(path, doc);
+    persist(collectionName, {&doc});
 
     auto id = doc.get<size_t>("id");
-    if(id && collection.getDocumentById(*id)) {
-        collection.update(doc);
+    if(id && collection->getDocumentById(*id)) {
+        collection->update(doc);
     }
     else {
-        collection.insert(doc);
+        collection->insert(doc);
     }
 }
\ No newline at end of file
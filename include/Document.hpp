@@ -28,6 +28,22 @@ public:
     template<typename T>
     void set(const std::string& key, const T& value);
 
+    /// @brief Add and set document's property, moving value into document
+    /// @details Const rvalue cannot be moved from, so it is copied by overload taking const reference
+    /// @tparam T Property's typename
+    /// @param key Name of property
+    /// @param value Value of property
+    template<typename T, typename = std::enable_if_t<!std::is_lvalue_reference_v<T> && !std::is_const_v<T>>>
+    void set(const std::string& key, T&& value);
+
+    /// @brief Add and set document's property, constructing value in place
+    /// @tparam T Property's typename
+    /// @tparam Args Types of T's constructor arguments
+    /// @param key Name of property
+    /// @param args Arguments of T's constructor
+    template<typename T, typename... Args>
+    void emplace(const std::string& key, Args&&... args);
+
     /// @brief Get copy of document's property
     /// @tparam T Property's typename
     /// @param key Name of property
@@ -83,6 +99,29 @@ void Document::set(const std::string& key, const T& value) {
     _data[key] = value;
 }
 
+template<typename T, typename>
+void Document::set(const std::string& key, T&& value) {
+    static_assert(is_valid_type<T>(), "Invalid type for Document");
+
+    if (key == "id" && !std::is_same_v<T, size_t>) {
+        throw std::invalid_argument("Field 'id' must be of type size_t");
+    }
+
+    _data[key] = std::move(value);
+}
+
+template<typename T, typename... Args>
+void Document::emplace(const std::string& key, Args&&... args) {
+    using Type = std::remove_cv_t<T>;
+    static_assert(is_valid_type<Type>(), "Invalid type for Document");
+
+    if (key == "id" && !std::is_same_v<Type, size_t>) {
+        throw std::invalid_argument("Field 'id' must be of type size_t");
+    }
+
+    _data.insert_or_assign(key, Value(std::in_place_type<Type>, std::forward<Args>(args)...));
+}
+
 template<typename T>
 std::optional<T> Document::get(const std::string& key) const {
     auto it = _data.find(key);
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <filesystem>
+
+/// @brief Force file or directory to disk with fsync, directory is synced so entries created, renamed or removed in it
+/// survive crash
+/// @param path Path of file or directory
+void syncPath(const std::filesystem::path& path);
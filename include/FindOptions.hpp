@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Projection.hpp"
+
+#include <optional>
+
+/// @brief Order of sorted find results
+struct SortKey {
+    /// @brief Name of top-level field to sort by, documents without orderable value of it go last
+    std::string field;
+
+    /// @brief True for ascending order, false for descending
+    bool ascending{true};
+};
+
+/// @brief Options shaping results of find
+struct FindOptions {
+    /// @brief Number of leading results to be dropped
+    size_t skip{0};
+
+    /// @brief Maximal number of returned results, scanning stops once it is reached
+    std::optional<size_t> limit;
+
+    /// @brief Order of results, with limit only best skip + limit results are kept while scanning
+    std::optional<SortKey> sort;
+
+    /// @brief Fields to be kept or dropped in returned results
+    std::optional<Projection> projection;
+};
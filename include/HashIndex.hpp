@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Document.hpp"
+#include "SlotMap.hpp"
+#include "ValueComparator.hpp"
+
+#include <unordered_set>
+
+/// @brief Represents hash index over single top-level field of documents
+class HashIndex {
+public:
+    /// @brief Set of handles of documents sharing the same value
+    using Postings = std::unordered_set<SlotHandle, SlotHandleHash>;
+
+    /// @brief Construct an index
+    /// @param field Name of indexed field
+    HashIndex(std::string field) : _field(std::move(field)) {}
+
+    /// @brief Add document to index
+    /// @param doc Document to be indexed
+    /// @param handle Handle of document in collection
+    void insert(const Document& doc, SlotHandle handle);
+
+    /// @brief Remove document from index
+    /// @param doc Document as it was indexed
+    /// @param handle Handle of document in collection
+    void remove(const Document& doc, SlotHandle handle);
+
+    /// @brief Find handles of documents which field is equal to value
+    /// @param value Value to look for
+    /// @return Pointer to handles if any document matches, nullptr otherwise
+    const Postings* find(const Document::Value& value) const;
+
+    /// @brief Get name of indexed field
+    /// @return Name of field
+    const std::string& getField() const { return _field; }
+
+private:
+    /// @brief Name of indexed field
+    std::string _field;
+
+    /// @brief Map of field value to handles of documents holding it
+    std::unordered_map<Document::Value, Postings, ValueHash, ValueEqual> _entries;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+
+/// @brief Strategy of generating document ids
+enum class IdStrategy {
+    /// @brief Random 64-bit ids, retried on collision
+    Random,
+
+    /// @brief Counter increasing by one, starting after largest id seen by collection
+    Monotonic,
+
+    /// @brief Milliseconds since 2024-01-01 UTC in upper bits and per-millisecond sequence in lower 22 bits
+    TimeOrdered
+};
+
+/// @brief Generates unique document ids of single collection
+class IdGenerator {
+public:
+    /// @brief Construct a generator
+    /// @param strategy Strategy of generating ids
+    explicit IdGenerator(IdStrategy strategy = IdStrategy::Random) : _strategy(strategy) {}
+
+    /// @brief Generate id
+    /// @param taken Ids already used in collection, only checked by IdStrategy::Random
+    /// @return Unique id, ordered strategies always return ids larger than any generated or observed one
+    size_t next(const std::unordered_set<size_t>& taken);
+
+    /// @brief Record id assigned outside of generator, so ordered strategies never issue it
+    /// @param id Id of inserted document
+    void observe(size_t id);
+
+    /// @brief Get strategy
+    /// @return Strategy of generating ids
+    IdStrategy getStrategy() const { return _strategy; }
+
+private:
+    /// @brief Strategy of generating ids
+    IdStrategy _strategy;
+
+    /// @brief Largest id generated or observed, ordered strategies continue after it
+    size_t _last{0};
+
+    /// @brief Random number generator
+    std::mt19937_64 _rng{std::random_device{}()};
+
+    /// @brief Number of low bits holding sequence of IdStrategy::TimeOrdered
+    static constexpr unsigned sequenceBits{22};
+
+    /// @brief Unix time in milliseconds of 2024-01-01 UTC, epoch of IdStrategy::TimeOrdered
+    static constexpr uint64_t epochMillis{1704067200000ull};
+};
@@ -2,24 +2,38 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 
 class Logger {
 public:
     /// @brief Log information to console
     /// @param message Message to log
     static void logInfo(std::string_view message) {
-        std::cout << "[INFO] " << message << std::endl;
+        write("[INFO] ", message);
     }
 
     /// @brief Log warning to console
     /// @param message Message to log
     static void logWarning(std::string_view message) {
-        std::cout << "[WARNING] " << message << std::endl;
+        write("[WARNING] ", message);
     }
 
     /// @brief Log error to console
     /// @param message Message to log
     static void logError(std::string_view message) {
-        std::cout << "[ERROR] " << message << std::endl;
+        write("[ERROR] ", message);
+    }
+
+private:
+    /// @brief Write whole line at once, so lines logged by concurrent threads do not interleave
+    /// @param level Prefix of log level
+    /// @param message Message to log
+    static void write(std::string_view level, std::string_view message) {
+        std::string line;
+        line.reserve(level.size() + message.size() + 1);
+        line.append(level).append(message).push_back('\n');
+
+        std::cout.write(line.data(), static_cast<std::streamsize>(line.size()));
+        std::cout.flush();
     }
 };
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+/// @brief Read-only view of whole file, memory-mapped with sequential access hint
+/// @details Files smaller than mapThreshold are read into owned buffer instead, mapping and unmapping them costs more
+/// than copying. View stays valid until file object is destroyed, file must not be truncated meanwhile.
+class MappedFile {
+public:
+    /// @brief Size from which files are mapped instead of read
+    static constexpr size_t mapThreshold{64 * 1024};
+
+    /// @brief Map or read file
+    /// @param path Path of file
+    explicit MappedFile(const std::filesystem::path& path);
+
+    /// @brief Unmap file
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// @brief Get contents of file
+    /// @return View of whole file
+    std::string_view data() const { return _data; }
+
+    /// @brief Check if file is memory-mapped
+    /// @return True if mapped, false if read into buffer
+    bool isMapped() const { return _mapping != nullptr; }
+
+private:
+    /// @brief Start of mapping, nullptr if file was read
+    void* _mapping{nullptr};
+
+    /// @brief Contents of file read into memory
+    std::string _buffer;
+
+    /// @brief View of contents of file
+    std::string_view _data;
+};
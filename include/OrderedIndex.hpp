@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Document.hpp"
+#include "SlotMap.hpp"
+#include "ValueComparator.hpp"
+
+#include <map>
+#include <unordered_set>
+
+/// @brief Represents bound of range query
+struct Bound {
+    /// @brief Value of bound
+    Document::Value value;
+
+    /// @brief True if value itself is in range, false otherwise
+    bool inclusive{true};
+};
+
+/// @brief Represents ordered index over single top-level field of documents, holding numbers and strings
+class OrderedIndex {
+public:
+    /// @brief Set of handles of documents sharing the same value
+    using Postings = std::unordered_set<SlotHandle, SlotHandleHash>;
+
+    /// @brief Construct an index
+    /// @param field Name of indexed field
+    OrderedIndex(std::string field) : _field(std::move(field)) {}
+
+    /// @brief Add document to index
+    /// @param doc Document to be indexed
+    /// @param handle Handle of document in collection
+    void insert(const Document& doc, SlotHandle handle);
+
+    /// @brief Remove document from index
+    /// @param doc Document as it was indexed
+    /// @param handle Handle of document in collection
+    void remove(const Document& doc, SlotHandle handle);
+
+    /// @brief Find handles of documents which field lies in range, numbers and strings are never mixed in one range
+    /// @param lower Lower bound, std::nullopt if range is not bounded from below
+    /// @param upper Upper bound, std::nullopt if range is not bounded from above
+    /// @return Handles ordered by field value
+    std::vector<SlotHandle> range(const std::optional<Bound>& lower, const std::optional<Bound>& upper) const;
+
+    /// @brief Count documents which field lies in range
+    /// @param lower Lower bound, std::nullopt if range is not bounded from below
+    /// @param upper Upper bound, std::nullopt if range is not bounded from above
+    /// @param limit Counting stops as soon as result exceeds limit
+    /// @return Number of documents, or first count exceeding limit
+    size_t count(const std::optional<Bound>& lower, const std::optional<Bound>& upper, size_t limit) const;
+
+    /// @brief Find handles of documents which string field starts with prefix
+    /// @param prefix Prefix to look for
+    /// @return Handles ordered by field value
+    std::vector<SlotHandle> prefix(const std::string& prefix) const;
+
+    /// @brief Check if value lies in range, with the same rules as range
+    /// @param value Value to check
+    /// @param lower Lower bound, std::nullopt if range is not bounded from below
+    /// @param upper Upper bound, std::nullopt if range is not bounded from above
+    /// @return True if value lies in range, false otherwise
+    static bool inRange(const Document::Value& value, const std::optional<Bound>& lower, const std::optional<Bound>& upper);
+
+    /// @brief Get name of indexed field
+    /// @return Name of field
+    const std::string& getField() const { return _field; }
+
+private:
+    /// @brief Map of field value to handles of documents holding it
+    using Entries = std::map<Document::Value, Postings, ValueLess>;
+
+    /// @brief Name of indexed field
+    std::string _field;
+
+    /// @brief Ordered map of field value to handles of documents holding it
+    Entries _entries;
+
+    /// @brief Find entries which lie in range
+    /// @param lower Lower bound, std::nullopt if range is not bounded from below
+    /// @param upper Upper bound, std::nullopt if range is not bounded from above
+    /// @return First entry and entry after last one, both end if range is empty
+    std::pair<Entries::const_iterator, Entries::const_iterator> locate(const std::optional<Bound>& lower, const std::optional<Bound>& upper) const;
+
+    /// @brief Append handles of entries in [first, last) to result
+    /// @param first First entry
+    /// @param last Entry after last one
+    /// @param handles Vector to fill
+    static void collect(Entries::const_iterator first, Entries::const_iterator last, std::vector<SlotHandle>& handles);
+};
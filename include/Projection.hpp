@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Document.hpp"
+
+/// @brief Represents selection of document fields to be materialized on read
+/// @details Paths are dotted, e.g. "address.location". A segment selects a field of document or a key of Document::Map,
+/// a segment reaching Document::Vector is applied to every element. Included projection always keeps top-level "id".
+class Projection {
+public:
+    /// @brief Create projection keeping only given paths
+    /// @param paths Dotted paths to be kept
+    /// @return Projection
+    static Projection include(const std::vector<std::string>& paths) { return Projection(true, paths); }
+
+    /// @brief Create projection keeping everything except given paths
+    /// @param paths Dotted paths to be dropped
+    /// @return Projection
+    static Projection exclude(const std::vector<std::string>& paths) { return Projection(false, paths); }
+
+    /// @brief Materialize projected copy of document
+    /// @param doc Source document
+    /// @return New document holding only projected parts of source
+    Document apply(const Document& doc) const;
+
+private:
+    /// @brief Represents tree of path segments
+    struct Node {
+        /// @brief Child segments
+        std::unordered_map<std::string, Node> children;
+
+        /// @brief True if some path ends at this segment
+        bool terminal{false};
+    };
+
+    /// @brief True if paths are kept, false if they are dropped
+    bool _include;
+
+    /// @brief Root of tree of path segments
+    Node _root;
+
+    /// @brief Construct a projection
+    /// @param include True if paths are kept, false if they are dropped
+    /// @param paths Dotted paths
+    Projection(bool include, const std::vector<std::string>& paths);
+
+    /// @brief Keep only selected fields of document
+    /// @param doc Source document
+    /// @param node Segments selected in document
+    /// @return Projected document
+    static Document includeFields(const Document& doc, const Node& node);
+
+    /// @brief Keep only selected parts of value
+    /// @param value Source value
+    /// @param node Segments selected in value
+    /// @return Projected value, std::nullopt if path does not exist in value
+    static std::optional<Document::Value> includeValue(const Document::Value& value, const Node& node);
+
+    /// @brief Drop selected fields of document
+    /// @param doc Source document
+    /// @param node Segments selected in document
+    /// @return Projected document
+    static Document excludeFields(const Document& doc, const Node& node);
+
+    /// @brief Drop selected parts of value
+    /// @param value Source value
+    /// @param node Segments selected in value
+    /// @return Projected value
+    static Document::Value excludeValue(const Document::Value& value, const Node& node);
+};
@@ -0,0 +1,218 @@
+#pragma once
+
+#include "Document.hpp"
+#include "ValueComparator.hpp"
+
+#include <type_traits>
+#include <vector>
+
+/// @brief Comparison operator of query predicate
+enum class Operator {
+    Equal,
+    NotEqual,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual
+};
+
+/// @brief Runtime description of single comparison of top-level field with constant
+struct Predicate {
+    /// @brief Name of compared field
+    std::string field;
+
+    /// @brief Comparison operator
+    Operator op;
+
+    /// @brief Constant which field is compared with
+    Document::Value value;
+
+    /// @brief Test document against predicate
+    /// @param doc Document to be tested
+    /// @return True if predicate holds, false otherwise
+    bool matches(const Document& doc) const;
+
+    /// @brief Test field's value against constant
+    /// @param op Comparison operator
+    /// @param fieldValue Value of field, nullptr if document does not have it
+    /// @param value Constant which field is compared with
+    /// @return True if comparison holds, missing field only satisfies Operator::NotEqual
+    static bool test(Operator op, const Document::Value* fieldValue, const Document::Value& value);
+};
+
+/// @brief Base of all query expressions, marks type as inspectable by Collection
+struct QueryExpression {};
+
+/// @brief Check if type is query expression
+/// @tparam T
+template<typename T>
+constexpr bool is_query_v = std::is_base_of_v<QueryExpression, std::decay_t<T>>;
+
+/// @brief Represents comparison of top-level field with constant
+/// @tparam Op Comparison operator
+template<Operator Op>
+class Comparison : public QueryExpression {
+public:
+    /// @brief Construct a comparison
+    /// @param field Name of compared field
+    /// @param value Constant which field is compared with
+    Comparison(std::string field, Document::Value value) : _field(std::move(field)), _value(std::move(value)) {}
+
+    /// @brief Evaluate comparison
+    /// @param doc Document to be tested
+    /// @return True if document matches, false otherwise
+    bool operator()(const Document& doc) const {
+        const auto& data = doc.getDataView();
+        auto it = data.find(_field);
+        return Predicate::test(Op, it != data.end() ? &it->second : nullptr, _value);
+    }
+
+    /// @brief Append predicates which all must hold for expression to match
+    /// @param predicates Vector to fill
+    /// @return True if appended predicates describe whole expression, false otherwise
+    bool collectConjuncts(std::vector<Predicate>& predicates) const {
+        predicates.push_back({_field, Op, _value});
+        return true;
+    }
+
+private:
+    /// @brief Name of compared field
+    std::string _field;
+
+    /// @brief Constant which field is compared with
+    Document::Value _value;
+};
+
+/// @brief Represents conjunction of two query expressions
+/// @tparam Lhs Query expression
+/// @tparam Rhs Query expression
+template<typename Lhs, typename Rhs>
+class And : public QueryExpression {
+public:
+    /// @brief Construct a conjunction
+    And(Lhs lhs, Rhs rhs) : _lhs(std::move(lhs)), _rhs(std::move(rhs)) {}
+
+    /// @brief Evaluate conjunction
+    /// @param doc Document to be tested
+    /// @return True if document matches both expressions, false otherwise
+    bool operator()(const Document& doc) const { return _lhs(doc) && _rhs(doc); }
+
+    /// @brief Append predicates which all must hold for expression to match
+    /// @param predicates Vector to fill
+    /// @return True if appended predicates describe whole expression, false otherwise
+    bool collectConjuncts(std::vector<Predicate>& predicates) const {
+        bool lhsComplete = _lhs.collectConjuncts(predicates);
+        bool rhsComplete = _rhs.collectConjuncts(predicates);
+        return lhsComplete && rhsComplete;
+    }
+
+private:
+    Lhs _lhs;
+    Rhs _rhs;
+};
+
+/// @brief Represents disjunction of two query expressions
+/// @tparam Lhs Query expression
+/// @tparam Rhs Query expression
+template<typename Lhs, typename Rhs>
+class Or : public QueryExpression {
+public:
+    /// @brief Construct a disjunction
+    Or(Lhs lhs, Rhs rhs) : _lhs(std::move(lhs)), _rhs(std::move(rhs)) {}
+
+    /// @brief Evaluate disjunction
+    /// @param doc Document to be tested
+    /// @return True if document matches any of expressions, false otherwise
+    bool operator()(const Document& doc) const { return _lhs(doc) || _rhs(doc); }
+
+    /// @brief Disjunction has no predicate which must hold, so nothing is appended
+    /// @return False, as expression is not described
+    bool collectConjuncts(std::vector<Predicate>&) const { return false; }
+
+private:
+    Lhs _lhs;
+    Rhs _rhs;
+};
+
+/// @brief Represents negation of query expression
+/// @tparam Expr Query expression
+template<typename Expr>
+class Not : public QueryExpression {
+public:
+    /// @brief Construct a negation
+    explicit Not(Expr expr) : _expr(std::move(expr)) {}
+
+    /// @brief Evaluate negation
+    /// @param doc Document to be tested
+    /// @return True if document does not match expression, false otherwise
+    bool operator()(const Document& doc) const { return !_expr(doc); }
+
+    /// @brief Negation has no predicate which must hold, so nothing is appended
+    /// @return False, as expression is not described
+    bool collectConjuncts(std::vector<Predicate>&) const { return false; }
+
+private:
+    Expr _expr;
+};
+
+/// @brief Represents top-level field of document, entry point of query expressions
+class Field {
+public:
+    /// @brief Construct a field
+    /// @param name Name of field
+    explicit Field(std::string name) : _name(std::move(name)) {}
+
+    template<typename T>
+    Comparison<Operator::Equal> operator==(T&& value) const { return {_name, toValue(std::forward<T>(value))}; }
+
+    template<typename T>
+    Comparison<Operator::NotEqual> operator!=(T&& value) const { return {_name, toValue(std::forward<T>(value))}; }
+
+    template<typename T>
+    Comparison<Operator::Less> operator<(T&& value) const { return {_name, toValue(std::forward<T>(value))}; }
+
+    template<typename T>
+    Comparison<Operator::LessEqual> operator<=(T&& value) const { return {_name, toValue(std::forward<T>(value))}; }
+
+    template<typename T>
+    Comparison<Operator::Greater> operator>(T&& value) const { return {_name, toValue(std::forward<T>(value))}; }
+
+    template<typename T>
+    Comparison<Operator::GreaterEqual> operator>=(T&& value) const { return {_name, toValue(std::forward<T>(value))}; }
+
+private:
+    /// @brief Name of field
+    std::string _name;
+
+    /// @brief Convert constant to Document::Value once, when query is built
+    /// @tparam T Type of constant, string literals are stored as std::string
+    template<typename T>
+    static Document::Value toValue(T&& value) {
+        if constexpr(std::is_convertible_v<T, std::string> && !std::is_same_v<std::decay_t<T>, std::string>) {
+            return std::string(std::forward<T>(value));
+        }
+        else {
+            return Document::Value(std::forward<T>(value));
+        }
+    }
+};
+
+/// @brief Create field for query expression, e.g. field("age") > 10 && field("name") == "x"
+/// @param name Name of top-level field
+/// @return Field
+inline Field field(std::string name) { return Field(std::move(name)); }
+
+template<typename Lhs, typename Rhs, typename = std::enable_if_t<is_query_v<Lhs> && is_query_v<Rhs>>>
+And<std::decay_t<Lhs>, std::decay_t<Rhs>> operator&&(Lhs&& lhs, Rhs&& rhs) {
+    return {std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)};
+}
+
+template<typename Lhs, typename Rhs, typename = std::enable_if_t<is_query_v<Lhs> && is_query_v<Rhs>>>
+Or<std::decay_t<Lhs>, std::decay_t<Rhs>> operator||(Lhs&& lhs, Rhs&& rhs) {
+    return {std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)};
+}
+
+template<typename Expr, typename = std::enable_if_t<is_query_v<Expr>>>
+Not<std::decay_t<Expr>> operator!(Expr&& expr) {
+    return Not<std::decay_t<Expr>>(std::forward<Expr>(expr));
+}
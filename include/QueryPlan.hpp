@@ -0,0 +1,67 @@
+#pragma once
+
+#include "OrderedIndex.hpp"
+#include "Query.hpp"
+
+/// @brief Kind of index over document field
+enum class IndexType {
+    /// @brief Hash index serving equality queries
+    Hash,
+    /// @brief Ordered index serving range and prefix queries
+    Ordered
+};
+
+/// @brief Represents lookup of candidate documents in single index
+struct AccessPath {
+    /// @brief Kind of used index
+    IndexType type;
+
+    /// @brief Name of indexed field
+    std::string field;
+
+    /// @brief Looked up value of hash index
+    std::optional<Document::Value> value;
+
+    /// @brief Lower bound of ordered index range
+    std::optional<Bound> lower;
+
+    /// @brief Upper bound of ordered index range
+    std::optional<Bound> upper;
+
+    /// @brief Estimated number of documents returned by lookup
+    size_t estimated{0};
+};
+
+/// @brief Represents plan chosen for query, with estimated and actual statistics
+struct QueryPlan {
+    /// @brief Index lookups which candidate sets are intersected, empty for full scan
+    std::vector<AccessPath> accessPaths;
+
+    /// @brief Predicates checked on every candidate, ordered by estimated selectivity
+    std::vector<Predicate> residual;
+
+    /// @brief True if residual predicates describe whole query, false if query has to be evaluated as well
+    bool complete{true};
+
+    /// @brief Estimated number of documents to be scanned
+    size_t estimatedScanned{0};
+
+    /// @brief Number of documents scanned when query was executed
+    size_t scanned{0};
+
+    /// @brief Number of documents returned when query was executed
+    size_t returned{0};
+
+    /// @brief Check if plan scans whole collection
+    /// @return True if no index is used, false otherwise
+    bool isFullScan() const { return accessPaths.empty(); }
+
+    /// @brief Check residual predicates
+    /// @param doc Candidate document
+    /// @return True if all residual predicates hold, false otherwise
+    bool matchesResidual(const Document& doc) const;
+
+    /// @brief Describe plan
+    /// @return Human readable description of plan and its statistics
+    std::string toString() const;
+};
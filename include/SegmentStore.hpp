@@ -0,0 +1,206 @@
+#pragma once
+
+#include "Document.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string_view>
+
+/// @brief Usage of single segment file
+struct SegmentStats {
+    /// @brief Number of segment
+    uint32_t segment{0};
+
+    /// @brief Size of segment file
+    uint64_t totalBytes{0};
+
+    /// @brief Bytes of records holding latest versions of documents
+    uint64_t liveBytes{0};
+
+    /// @brief Bytes of tombstones, kept by compaction while older segment may hold removed document
+    uint64_t tombstoneBytes{0};
+
+    /// @brief Get part of segment taken by superseded records and tombstones, which hold no live document
+    /// @return Ratio in range [0, 1]
+    double deadRatio() const {
+        return totalBytes == 0 ? 0.0 : static_cast<double>(totalBytes - liveBytes) / static_cast<double>(totalBytes);
+    }
+};
+
+/// @brief Log-structured store of documents of single collection
+/// @details Documents are appended as records to segment files <number>.seg in collection's directory. Update appends
+/// new version of document, remove appends tombstone. Record is type byte, little-endian id (8 bytes), payload size
+/// (4 bytes) and checksum (4 bytes), followed by BinaryCodec encoded document. Map of id to location of latest version
+/// is rebuilt on open, torn record at the end of last segment is cut off. All methods are thread safe, compaction
+/// rewrites segment without holding the lock, so readers and writers continue meanwhile.
+class SegmentStore {
+public:
+    /// @brief Default size after which new segment is started
+    static constexpr uint64_t defaultMaxSegmentSize{64ull << 20};
+
+    /// @brief Construct a store
+    /// @param directory Collection's directory
+    /// @param maxSegmentSize Size after which new segment is started
+    explicit SegmentStore(std::filesystem::path directory, uint64_t maxSegmentSize = defaultMaxSegmentSize);
+
+    /// @brief Load live documents and rebuild map of their locations
+    /// @return Latest versions of documents which were not removed, in order of their first insertion
+    std::vector<Document> load();
+
+    /// @brief Append document
+    /// @param doc Document to be saved, must have id
+    void put(const Document& doc);
+
+    /// @brief Append documents with single write
+    /// @param docs Documents to be saved, must have ids
+    void put(const std::vector<const Document*>& docs);
+
+    /// @brief Append tombstone of document
+    /// @param id Document's id
+    /// @return True if document was stored, false otherwise
+    bool remove(size_t id);
+
+    /// @brief Check if document is stored
+    /// @param id Document's id
+    /// @return True if live version of document exists
+    bool contains(size_t id);
+
+    /// @brief Read latest version of document
+    /// @param id Document's id
+    /// @return Document, std::nullopt if it is not stored
+    std::optional<Document> get(size_t id);
+
+    /// @brief Get number of live documents
+    /// @return Number of documents
+    size_t size();
+
+    /// @brief Remove all segment files
+    void clear();
+
+    /// @brief Force segments appended since last sync to disk, together with directory listing them
+    void sync();
+
+    /// @brief Stop using directory, running compaction discards its result
+    void close();
+
+    /// @brief Get usage of every segment
+    /// @return Stats in ascending order of segments
+    std::vector<SegmentStats> stats();
+
+    /// @brief Rewrite sealed segments with enough dead records, keeping only live ones
+    /// @param deadRatio Minimal part of segment taken by dead records to rewrite it
+    /// @param bytesPerSecond Limit of read and written bytes per second, 0 for no limit
+    /// @return Number of rewritten segments
+    size_t compact(double deadRatio, uint64_t bytesPerSecond = 0);
+
+    /// @brief Check if file is segment file
+    /// @param path Path of file
+    /// @return True if file has segment extension
+    static bool isSegment(const std::filesystem::path& path) { return path.extension() == ".seg"; }
+
+    /// @brief Check if directory holds any segment file
+    /// @param directory Collection's directory
+    /// @return True if segment file exists
+    static bool hasSegments(const std::filesystem::path& directory);
+
+private:
+    /// @brief Type of record
+    enum class RecordType : uint8_t {
+        Put = 1,
+        Tombstone = 2
+    };
+
+    /// @brief Location of payload of latest version of document
+    struct Location {
+        /// @brief Number of segment
+        uint32_t segment;
+
+        /// @brief Offset of payload in segment
+        uint64_t offset;
+
+        /// @brief Size of payload
+        uint32_t size;
+    };
+
+    /// @brief Size of record header
+    static constexpr size_t headerSize{17};
+
+    /// @brief Mutex guarding state and files
+    std::mutex _mutex;
+
+    /// @brief Usage of segments by their number
+    std::unordered_map<uint32_t, SegmentStats> _stats;
+
+    /// @brief True once store was closed
+    bool _closed{false};
+
+    /// @brief Collection's directory
+    std::filesystem::path _directory;
+
+    /// @brief Size after which new segment is started
+    uint64_t _maxSegmentSize;
+
+    /// @brief Numbers of segments in ascending order, last one is active
+    std::vector<uint32_t> _segments;
+
+    /// @brief Map of document id to location of its latest version
+    std::unordered_map<size_t, Location> _locations;
+
+    /// @brief Stream appending to active segment
+    std::ofstream _active;
+
+    /// @brief Size of active segment
+    uint64_t _activeSize{0};
+
+    /// @brief Segments appended since last sync
+    std::vector<uint32_t> _unsynced;
+
+    /// @brief True once segments were scanned
+    bool _loaded{false};
+
+    /// @brief Scan all segments, rebuilding locations and stats
+    /// @param documents If not nullptr, filled with live documents
+    void scan(std::vector<Document>* documents);
+
+    /// @brief Scan segments once, caller must hold the lock
+    void ensureLoaded() {
+        if(!_loaded) {
+            scan(nullptr);
+        }
+    }
+
+    /// @brief Move latest version of document, updating stats of segments
+    /// @param id Document's id
+    /// @param location New location, std::nullopt if document was removed
+    void relocate(size_t id, std::optional<Location> location);
+
+    /// @brief Rewrite single sealed segment
+    /// @param segment Number of segment
+    /// @param bytesPerSecond Limit of read and written bytes per second, 0 for no limit
+    /// @return True if segment was rewritten
+    bool compactSegment(uint32_t segment, uint64_t bytesPerSecond);
+
+    /// @brief Append encoded records to active segment and record locations of put documents
+    /// @param records Encoded records
+    /// @param puts Ids and payload offsets in records of put documents
+    void append(const std::string& records, const std::vector<std::pair<size_t, Location>>& puts);
+
+    /// @brief Encode record
+    /// @param type Type of record
+    /// @param id Document's id
+    /// @param payload Encoded document, empty for tombstone
+    /// @param out Buffer to append to
+    static void encodeRecord(RecordType type, size_t id, std::string_view payload, std::string& out);
+
+    /// @brief Compute checksum of record
+    /// @param header First 13 bytes of record header
+    /// @param payload Payload of record
+    /// @return FNV-1a hash of header and payload
+    static uint32_t checksum(std::string_view header, std::string_view payload);
+
+    /// @brief Get path of segment
+    /// @param segment Number of segment
+    /// @return Path of segment file
+    std::filesystem::path segmentPath(uint32_t segment) const;
+};
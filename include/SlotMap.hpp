@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+/// @brief Generational handle of value stored in SlotMap, stays valid until the value is erased
+struct SlotHandle {
+    /// @brief Index of slot
+    uint32_t index{std::numeric_limits<uint32_t>::max()};
+
+    /// @brief Generation of slot at time handle was issued
+    uint32_t generation{0};
+
+    friend bool operator==(const SlotHandle& lhs, const SlotHandle& rhs) { return lhs.index == rhs.index && lhs.generation == rhs.generation; }
+    friend bool operator!=(const SlotHandle& lhs, const SlotHandle& rhs) { return !(lhs == rhs); }
+};
+
+/// @brief Hash of SlotHandle
+struct SlotHandleHash {
+    size_t operator()(const SlotHandle& handle) const {
+        return std::hash<uint64_t>{}((static_cast<uint64_t>(handle.generation) << 32) | handle.index);
+    }
+};
+
+/// @brief Container keeping values densely packed while handing out handles which survive inserts and erases
+/// @details Values live in one contiguous vector, so they can be scanned like std::vector. Erasing single value moves
+/// last value into its position, so scans are no longer in insertion order, but handles keep resolving to moved values.
+/// Handle of erased value is rejected, even if its slot is reused.
+/// @tparam T Type of stored values
+template<typename T>
+class SlotMap {
+public:
+    /// @brief Insert value at end of dense storage
+    /// @param value Value to be inserted
+    /// @return Handle of value
+    SlotHandle insert(T value);
+
+    /// @brief Erase value in constant time, last value is moved into its position
+    /// @param handle Handle of value
+    /// @return True if value was erased, false if handle is stale
+    bool erase(SlotHandle handle);
+
+    /// @brief Erase values in single pass, keeping order of remaining ones
+    /// @param positions Ascending positions in dense storage
+    void erasePositions(const std::vector<size_t>& positions);
+
+    /// @brief Get value by handle
+    /// @param handle Handle of value
+    /// @return Pointer to value, nullptr if handle is stale
+    T* get(SlotHandle handle) { return contains(handle) ? &_values[_slots[handle.index].position] : nullptr; }
+
+    /// @brief Get value by handle
+    /// @param handle Handle of value
+    /// @return Pointer to value, nullptr if handle is stale
+    const T* get(SlotHandle handle) const { return contains(handle) ? &_values[_slots[handle.index].position] : nullptr; }
+
+    /// @brief Get current position of value in dense storage
+    /// @param handle Handle of value
+    /// @return Position, std::nullopt if handle is stale
+    std::optional<size_t> position(SlotHandle handle) const;
+
+    /// @brief Get handle of value at position in dense storage
+    /// @param position Position of value, must be lower than size()
+    /// @return Handle of value
+    SlotHandle handleAt(size_t position) const;
+
+    /// @brief Check if handle refers to stored value
+    /// @param handle Handle to check
+    /// @return True if value is stored, false if handle is stale
+    bool contains(SlotHandle handle) const {
+        return handle.index < _slots.size() && _slots[handle.index].generation == handle.generation && _slots[handle.index].occupied;
+    }
+
+    T& operator[](size_t position) { return _values[position]; }
+    const T& operator[](size_t position) const { return _values[position]; }
+
+    /// @brief Get densely packed values
+    /// @return Vector of values, invalidated by insert and erase
+    const std::vector<T>& values() const { return _values; }
+
+    size_t size() const { return _values.size(); }
+    bool empty() const { return _values.empty(); }
+
+    void reserve(size_t size) {
+        _values.reserve(size);
+        _owners.reserve(size);
+    }
+
+    typename std::vector<T>::iterator begin() { return _values.begin(); }
+    typename std::vector<T>::iterator end() { return _values.end(); }
+    typename std::vector<T>::const_iterator begin() const { return _values.begin(); }
+    typename std::vector<T>::const_iterator end() const { return _values.end(); }
+
+private:
+    /// @brief Indirection between handle and position in dense storage
+    struct Slot {
+        /// @brief Position of value in dense storage
+        size_t position{0};
+
+        /// @brief Incremented every time slot is freed
+        uint32_t generation{0};
+
+        /// @brief True if slot refers to stored value
+        bool occupied{false};
+    };
+
+    /// @brief Densely packed values
+    std::vector<T> _values;
+
+    /// @brief Index of slot owning value at each position of dense storage
+    std::vector<uint32_t> _owners;
+
+    /// @brief Slots, never shrinks
+    std::vector<Slot> _slots;
+
+    /// @brief Indexes of free slots
+    std::vector<uint32_t> _free;
+
+    /// @brief Mark slot as free, so handles referring to it become stale
+    /// @param index Index of slot
+    void release(uint32_t index);
+};
+
+template<typename T>
+SlotHandle SlotMap<T>::insert(T value) {
+    uint32_t index;
+    if(!_free.empty()) {
+        index = _free.back();
+        _free.pop_back();
+    }
+    else {
+        if(_slots.size() >= std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("SlotMap is full.");
+        }
+        index = static_cast<uint32_t>(_slots.size());
+        _slots.emplace_back();
+    }
+
+    auto& slot = _slots[index];
+    slot.position = _values.size();
+    slot.occupied = true;
+
+    _values.push_back(std::move(value));
+    _owners.push_back(index);
+
+    return SlotHandle{index, slot.generation};
+}
+
+template<typename T>
+bool SlotMap<T>::erase(SlotHandle handle) {
+    if(!contains(handle)) {
+        return false;
+    }
+
+    size_t position = _slots[handle.index].position;
+    size_t last = _values.size() - 1;
+    if(position != last) {
+        _values[position] = std::move(_values[last]);
+        _owners[position] = _owners[last];
+        _slots[_owners[position]].position = position;
+    }
+
+    _values.pop_back();
+    _owners.pop_back();
+    release(handle.index);
+
+    return true;
+}
+
+template<typename T>
+void SlotMap<T>::erasePositions(const std::vector<size_t>& positions) {
+    if(positions.empty()) {
+        return;
+    }
+
+    size_t write{positions.front()};
+    size_t next{0};
+    for(size_t read{positions.front()}; read < _values.size(); ++read) {
+        if(next < positions.size() && positions[next] == read) {
+            release(_owners[read]);
+            ++next;
+            continue;
+        }
+
+        _values[write] = std::move(_values[read]);
+        _owners[write] = _owners[read];
+        _slots[_owners[write]].position = write;
+        ++write;
+    }
+
+    _values.erase(_values.begin() + write, _values.end());
+    _owners.erase(_owners.begin() + write, _owners.end());
+}
+
+template<typename T>
+std::optional<size_t> SlotMap<T>::position(SlotHandle handle) const {
+    if(!contains(handle)) {
+        return std::nullopt;
+    }
+
+    return _slots[handle.index].position;
+}
+
+template<typename T>
+SlotHandle SlotMap<T>::handleAt(size_t position) const {
+    uint32_t index = _owners[position];
+    return SlotHandle{index, _slots[index].generation};
+}
+
+template<typename T>
+void SlotMap<T>::release(uint32_t index) {
+    auto& slot = _slots[index];
+    slot.occupied = false;
+    ++slot.generation;
+    _free.push_back(index);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Collection.hpp"
+
+#include <filesystem>
+
+/// @brief Binary image of whole collection, loaded with one sequential read instead of parsing document files
+/// @details Image starts with magic "DSNP" and version byte, followed by little-endian LSN of write-ahead log (8 bytes)
+/// covered by image, varint number of indexes, each being varint-prefixed field and index type byte, varint number of
+/// documents, each being varint-prefixed BinaryCodec encoded document, and checksum of all preceding bytes (4 bytes).
+struct Snapshot {
+    /// @brief Name of snapshot file in collection's directory
+    static constexpr std::string_view fileName{"collection.snap"};
+
+    /// @brief LSN of last write-ahead log record reflected in snapshot
+    uint64_t lsn{0};
+
+    /// @brief Indexed fields and kinds of their indexes
+    std::vector<std::pair<std::string, IndexType>> indexes;
+
+    /// @brief Documents of collection
+    std::vector<Document> documents;
+
+    /// @brief Write snapshot of collection, replacing previous one atomically
+    /// @param directory Collection's directory
+    /// @param collection Collection to be written
+    /// @param lsn LSN of last write-ahead log record reflected in collection
+    static void write(const std::filesystem::path& directory, const Collection& collection, uint64_t lsn);
+
+    /// @brief Read snapshot of collection
+    /// @param directory Collection's directory
+    /// @return Snapshot, std::nullopt if it does not exist or is damaged
+    static std::optional<Snapshot> read(const std::filesystem::path& directory);
+
+    /// @brief Read only LSN from header of snapshot, without reading and verifying documents
+    /// @param directory Collection's directory
+    /// @return LSN, std::nullopt if snapshot does not exist or has no valid header
+    static std::optional<uint64_t> readLsn(const std::filesystem::path& directory);
+
+    /// @brief Remove snapshot of collection
+    /// @param directory Collection's directory
+    static void remove(const std::filesystem::path& directory);
+
+private:
+    /// @brief Magic and version starting every snapshot
+    static constexpr std::string_view header{"DSNP\x01"};
+};
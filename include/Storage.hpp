@@ -1,105 +1,217 @@
+#pragma once
+
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
+#include "Compactor.hpp"
 #include "Document.hpp"
 #include "Logger.hpp"
+#include "SegmentStore.hpp"
+#include "ThreadPool.hpp"
+
+/// @brief Format of document files
+enum class StorageFormat {
+    /// @brief Tab-indented text with type names, stored in <id>.txt
+    Text,
+
+    /// @brief Compact BinaryCodec encoding, stored in <id>.bin
+    Binary,
+
+    /// @brief BinaryCodec encoded records appended to few large segment files, see SegmentStore
+    Segment
+};
 
 /// @brief Represents storage providing saving and loading database files
 class Storage {
 public:
-    /// @brief Load all documents in collection
+    /// @brief Construct a storage
+    /// @param format Format of saved documents, documents of all formats are always loaded
+    /// @param compaction Options of compaction of segment stores
+    explicit Storage(StorageFormat format = StorageFormat::Text, CompactionOptions compaction = {})
+        : _format(format), _compactor(std::make_unique<Compactor>(compaction)) {}
+
+    /// @brief Get format of saved documents
+    /// @return Storage format
+    StorageFormat getFormat() const { return _format; }
+
+    /// @brief Set format of saved documents
+    /// @param format Storage format
+    void setFormat(StorageFormat format) { _format = format; }
+
+    /// @brief Load all documents in collection, safe to call concurrently for different collections
     /// @param collectionPath Collection's path to load
-    /// @return Documents
-    std::vector<Document> loadDocuments(const std::string& collectionPath);
+    /// @param execution Execution mode, parallel modes parse document files on shared thread pool
+    /// @return Documents in order of directory listing
+    std::vector<Document> loadDocuments(const std::string& collectionPath, Execution execution = Execution::Sequential);
 
     /// @brief Save document in collection
     /// @param collectionPath Collection's path to save document
     /// @param doc Document to be saved
     void saveDocument(std::string collectionPath, const Document& doc);
 
+    /// @brief Save many documents in collection, serializing all of them into one reused buffer
+    /// @param collectionPath Collection's path to save documents
+    /// @param docs Documents to be saved
+    void saveDocuments(const std::string& collectionPath, const std::vector<const Document*>& docs);
+
+    /// @brief Force documents of collection saved or removed since last sync to disk
+    /// @param collectionPath Collection's path
+    /// @param ids Ids of saved or removed documents
+    void syncDocuments(const std::string& collectionPath, const std::unordered_set<size_t>& ids);
+
     /// @brief Remove document from collection
     /// @param path Collection's path
     /// @param id Document's id to be removed
     void removeDocument(const std::filesystem::path& path, size_t id);
 
+    /// @brief Rewrite every document file of collection in given format
+    /// @param collectionPath Collection's path
+    /// @param format Target format, files already in it are left untouched
+    void convertCollection(const std::string& collectionPath, StorageFormat format);
+
+    /// @brief Close segment store of collection, must be called before collection's directory is removed
+    /// @param collectionPath Collection's path
+    void closeCollection(const std::string& collectionPath);
+
+    /// @brief Compact segment stores of all open collections on calling thread
+    /// @return Number of rewritten segments
+    size_t compact() { return _compactor->compact(); }
+
 private:
-    /// @brief Write tabs
-    /// @param file File to write
-    /// @param amount Amount of tabs to write
-    void saveTabs(std::ofstream& file, size_t amount);
+    /// @brief Format of saved documents
+    StorageFormat _format;
 
-    /// @brief Save document in collection (implementation)
+    /// @brief Open segment stores by collection's path, shared with compactor
+    std::unordered_map<std::string, std::shared_ptr<SegmentStore>> _segmentStores;
+
+    /// @brief Mutex guarding map of segment stores, collections may be loaded concurrently
+    mutable std::mutex _segmentStoresMutex;
+
+    /// @brief Compactor of open segment stores
+    std::unique_ptr<Compactor> _compactor;
+
+    /// @brief Get segment store of collection, opening it on first use
+    /// @param collectionPath Collection's path
+    /// @return Segment store
+    SegmentStore& segmentStore(const std::filesystem::path& collectionPath);
+
+    /// @brief Check if collection keeps any document in segments
     /// @param collectionPath Collection's path
+    /// @return True if segment store is open or segment file exists
+    bool hasSegmentStore(const std::filesystem::path& collectionPath) const;
+
+    /// @brief Get extension of document files
+    /// @param format Storage format
+    /// @return Extension with leading dot
+    static std::string extension(StorageFormat format);
+
+    /// @brief Save document in given format
+    /// @param collectionPath Collection's path to save document
     /// @param doc Document to be saved
-    /// @param tabs Number of tabs to start a line
-    void saveDocument(std::string collectionPath, const Document& doc, size_t tabs);
+    /// @param format Storage format
+    /// @param buffer Buffer reused between documents, each document is written from it with one write
+    void writeDocument(const std::string& collectionPath, const Document& doc, StorageFormat format, std::string& buffer);
+
+    /// @brief Load single document file of any format
+    /// @param path Path of file
+    /// @return Document, std::nullopt if file is not a document file or could not be read
+    std::optional<Document> loadDocument(const std::filesystem::path& path);
+
+    /// @brief Append tabs
+    /// @param out Buffer to append to
+    /// @param amount Amount of tabs to write
+    static void saveTabs(std::string& out, size_t amount);
 
-    /// @brief Save single document
+    /// @brief Append number formatted as by output stream, without allocating
+    /// @tparam Number Arithmetic type
+    /// @param out Buffer to append to
+    /// @param value Number to append
+    template<typename Number>
+    static void appendNumber(std::string& out, Number value);
+
+    /// @brief Replace contents of file with one write
+    /// @param path Path of file
+    /// @param data Whole contents of file
+    static void writeFile(const std::filesystem::path& path, std::string_view data);
+
+    /// @brief Serialize single document in text format
     /// @param doc Document to save
     /// @param tabs Number of tabs to start a line
-    /// @param file File to save document
-    void saveSingleDocument(const Document& doc, size_t tabs, std::ofstream& file);
+    /// @param out Buffer to append to
+    static void saveSingleDocument(const Document& doc, size_t tabs, std::string& out);
 
-    /// @brief Parse single document
-    /// @param file Input document's file
+    /// @brief Parse single document, consuming its lines
+    /// @param text Remaining text of document's file
     /// @return Read document
-    Document parseDocument(std::ifstream& file);
+    Document parseDocument(std::string_view& text);
 
-     /// @brief Parse single vector
-    /// @param file Input document's file
+    /// @brief Parse single vector, consuming its lines
+    /// @param text Remaining text of document's file
     /// @return Read vector
-    Document::Vector parseVector(std::ifstream& file);
+    Document::Vector parseVector(std::string_view& text);
 
-     /// @brief Parse single map
-    /// @param file Input document's file
+    /// @brief Parse single map, consuming its lines
+    /// @param text Remaining text of document's file
     /// @return Read map
-    Document::Map parseMap(std::ifstream& file);
+    Document::Map parseMap(std::string_view& text);
 
     /// @brief Remove leading and trailing whitespaces from a string
     /// @param source String to be trimmed
-    /// @return New trimmed string
-    std::string trim(const std::string& source);
+    /// @return View of trimmed part of source
+    static std::string_view trim(std::string_view source);
+
+    /// @brief Consume next line of text
+    /// @param text Remaining text, advanced past the line
+    /// @return View of trimmed line
+    static std::string_view nextLine(std::string_view& text);
 
     /// @brief Extract key from trimmed line
-    /// @param trimmed Trimmed string to extract key
-    /// @return New string representing key
-    std::string parseKey(const std::string& trimmed);
+    /// @param trimmed Trimmed line to extract key
+    /// @return View of key, empty if line has single token
+    static std::string_view parseKey(std::string_view trimmed);
 
     /// @brief Extract type from trimmed line
-    /// @param trimmed Trimmed string to extract type
-    /// @return New string representing type
-    std::string parseType(const std::string& trimmed);
+    /// @param trimmed Trimmed line to extract type
+    /// @return View of type, empty if line has none
+    static std::string_view parseType(std::string_view trimmed);
 
     /// @brief Extract value from trimmed line
-    /// @param trimmed Trimmed string to extract value
-    /// @return New string representing value
-    std::string parseValue(const std::string& trimmed);
+    /// @param trimmed Trimmed line to extract value
+    /// @return View of value
+    static std::string_view parseValue(std::string_view trimmed);
 
-    /// @brief Extract special character from trimmed line
-    /// @param trimmed Trimmed string to extract special character
-    /// @return New characted representing special character
-    char parseSpecial(const std::string& trimmed);
+    /// @brief Convert value to number without allocating
+    /// @tparam Number Arithmetic type
+    /// @param value Text of number
+    /// @return Number
+    template<typename Number>
+    static Number parseNumber(std::string_view value);
 
     /// @brief Check if a line is start of Document
-    /// @param trimmed Rrimmed line
+    /// @param trimmed Trimmed line
     /// @param key Key extracted from line
     /// @param type Type extracted from line
     /// @return True if it is start, false otherwise
-    bool isDocumentStart(const std::string& trimmed, std::string& key, const std::string& type);
+    static bool isDocumentStart(std::string_view trimmed, std::string_view key, std::string_view type);
 
     /// @brief Check if a line is start of Document::Vector
-    /// @param trimmed Rrimmed line
+    /// @param trimmed Trimmed line
     /// @param key Key extracted from line
     /// @param type Type extracted from line
     /// @return True if it is start, false otherwise
-    bool isVectorStart(const std::string& trimmed, const std::string& key, const std::string& type);
+    static bool isVectorStart(std::string_view trimmed, std::string_view key, std::string_view type);
 
     /// @brief Check if a line is start of Document::Map
-    /// @param trimmed Rrimmed line
+    /// @param trimmed Trimmed line
     /// @param key Key extracted from line
     /// @param type Type extracted from line
     /// @return True if it is start, false otherwise
-    bool isMapStart(const std::string& trimmed, const std::string& key, const std::string& type);
+    static bool isMapStart(std::string_view trimmed, std::string_view key, std::string_view type);
 };
\ No newline at end of file
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/// @brief Execution mode of scans over collection
+enum class Execution {
+    /// @brief Scan on calling thread
+    Sequential,
+    /// @brief Scan partitions concurrently, results keep collection order
+    Parallel,
+    /// @brief Scan partitions concurrently, results are merged as partitions finish
+    ParallelUnordered
+};
+
+/// @brief Represents fixed size pool of worker threads
+class ThreadPool {
+public:
+    /// @brief Construct a pool
+    /// @param threads Number of worker threads, at least one is created
+    explicit ThreadPool(size_t threads);
+
+    /// @brief Finish queued tasks and join workers
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// @brief Get pool shared by whole process, sized to hardware concurrency
+    /// @return Reference to shared pool
+    static ThreadPool& shared();
+
+    /// @brief Get number of worker threads
+    /// @return Number of workers
+    size_t size() const { return _workers.size(); }
+
+    /// @brief Queue task
+    /// @tparam Task Function without parameters
+    /// @param task Task to be run on worker thread
+    /// @return Future of task's result
+    template<typename Task>
+    std::future<std::invoke_result_t<Task>> submit(Task&& task);
+
+    /// @brief Split [0, count) into chunks and run function on each of them, calling thread takes part in work
+    /// @tparam Function Function of format: void **Function**(size_t chunk, size_t begin, size_t end)
+    /// @param count Number of elements
+    /// @param chunks Number of chunks, chunks are claimed dynamically by idle threads
+    /// @param function Function processing single chunk
+    template<typename Function>
+    void parallelFor(size_t count, size_t chunks, Function&& function);
+
+private:
+    /// @brief Worker threads
+    std::vector<std::thread> _workers;
+
+    /// @brief Queued tasks
+    std::queue<std::function<void()>> _tasks;
+
+    /// @brief Mutex guarding queue
+    std::mutex _mutex;
+
+    /// @brief Signals new task or stopping
+    std::condition_variable _available;
+
+    /// @brief True if pool is being destroyed
+    bool _stopping{false};
+
+    /// @brief Queue type-erased task
+    /// @param task Task to be queued
+    void enqueue(std::function<void()> task);
+
+    /// @brief Loop of worker thread
+    void work();
+};
+
+
+
+
+
+template<typename Task>
+std::future<std::invoke_result_t<Task>> ThreadPool::submit(Task&& task) {
+    using Result = std::invoke_result_t<Task>;
+
+    auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+    auto future = packaged->get_future();
+    enqueue([packaged]() { (*packaged)(); });
+
+    return future;
+}
+
+template<typename Function>
+void ThreadPool::parallelFor(size_t count, size_t chunks, Function&& function) {
+    chunks = std::min(chunks, count);
+    if(chunks == 0) {
+        return;
+    }
+
+    struct State {
+        std::atomic<size_t> next{0};
+        size_t done{0};
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    auto state = std::make_shared<State>();
+
+    // Late helpers find no chunk left and return without touching function
+    auto run = [state, count, chunks, &function]() {
+        for(size_t chunk = state->next++; chunk < chunks; chunk = state->next++) {
+            std::exception_ptr error;
+            try {
+                function(chunk, count * chunk / chunks, count * (chunk + 1) / chunks);
+            }
+            catch(...) {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if(error && !state->error) {
+                state->error = error;
+            }
+            if(++state->done == chunks) {
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min(chunks, size() + 1) - 1;
+    for(size_t i{0}; i < helpers; ++i) {
+        enqueue(run);
+    }
+
+    run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&]() { return state->done == chunks; });
+
+    if(state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Document.hpp"
+
+/// @brief Provides comparison of Document::Value, numeric alternatives (int, size_t, double) are compared by value
+class ValueComparator {
+public:
+    /// @brief Check if value holds int, size_t or double
+    /// @param value Value to check
+    /// @return True if value is numeric, false otherwise
+    static bool isNumeric(const Document::Value& value);
+
+    /// @brief Check if value can be used as index key
+    /// @param value Value to check
+    /// @return True if value is int, size_t, double, std::string or bool, false for nested documents and containers
+    static bool isScalar(const Document::Value& value);
+
+    /// @brief Check if value can be used as ordered index key
+    /// @param value Value to check
+    /// @return True if value is numeric (except NaN) or std::string, false otherwise
+    static bool isOrderable(const Document::Value& value);
+
+    /// @brief Compare values
+    /// @param lhs First value
+    /// @param rhs Second value
+    /// @return Negative if lhs < rhs, zero if equal, positive if lhs > rhs, std::nullopt if values are not comparable
+    static std::optional<int> compare(const Document::Value& lhs, const Document::Value& rhs);
+
+    /// @brief Total order over orderable values, all numbers go before all strings
+    /// @param lhs First value, must be orderable
+    /// @param rhs Second value, must be orderable
+    /// @return Negative if lhs goes before rhs, zero if equal, positive otherwise
+    static int order(const Document::Value& lhs, const Document::Value& rhs);
+
+    /// @brief Check if values are equal
+    /// @param lhs First value
+    /// @param rhs Second value
+    /// @return True if values are equal, numeric values are equal if they represent the same number
+    static bool equal(const Document::Value& lhs, const Document::Value& rhs);
+
+    /// @brief Hash value consistently with equal
+    /// @param value Value to hash
+    /// @return Hash of value
+    static size_t hash(const Document::Value& value);
+};
+
+/// @brief Hash functor for Document::Value
+struct ValueHash {
+    size_t operator()(const Document::Value& value) const { return ValueComparator::hash(value); }
+};
+
+/// @brief Equality functor for Document::Value
+struct ValueEqual {
+    bool operator()(const Document::Value& lhs, const Document::Value& rhs) const { return ValueComparator::equal(lhs, rhs); }
+};
+
+/// @brief Less functor for orderable Document::Value
+struct ValueLess {
+    bool operator()(const Document::Value& lhs, const Document::Value& rhs) const { return ValueComparator::order(lhs, rhs) < 0; }
+};
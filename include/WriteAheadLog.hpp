@@ -0,0 +1,184 @@
+#pragma once
+
+#include "Document.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+/// @brief When written log records are forced to disk
+enum class SyncPolicy {
+    /// @brief Every commit waits for fsync, concurrent commits share one
+    Always,
+
+    /// @brief Commits return once written, background thread fsyncs periodically
+    Interval,
+
+    /// @brief Log is never fsynced, operating system decides when it reaches disk
+    Never
+};
+
+/// @brief Options of write-ahead log
+struct WalOptions {
+    /// @brief True to log mutations and update document files lazily at checkpoints
+    bool enabled{false};
+
+    /// @brief When log is forced to disk
+    SyncPolicy sync{SyncPolicy::Always};
+
+    /// @brief Time between fsyncs of SyncPolicy::Interval
+    std::chrono::milliseconds syncInterval{100};
+
+    /// @brief Size of log after which checkpoint is taken
+    uint64_t checkpointBytes{16ull << 20};
+};
+
+/// @brief Single mutation read back from log
+struct WalRecord {
+    /// @brief Kind of mutation
+    enum class Type : uint8_t {
+        Put = 1,
+        Remove = 2
+    };
+
+    /// @brief Log sequence number, position right after record
+    uint64_t lsn{0};
+
+    /// @brief Kind of mutation
+    Type type{Type::Put};
+
+    /// @brief Name of mutated collection
+    std::string collection;
+
+    /// @brief Id of mutated document
+    size_t id{0};
+
+    /// @brief Saved document, std::nullopt for removal
+    std::optional<Document> doc;
+};
+
+/// @brief Append-only log of database mutations with group commit
+/// @details Log starts with magic "DWAL" and little-endian base LSN (8 bytes). Record is little-endian size (4 bytes)
+/// and checksum (4 bytes) of body, body is type byte, varint-prefixed collection name, id (8 bytes) and BinaryCodec
+/// encoded document. LSN of record is base LSN plus offset of its end, so it keeps growing when log is reset.
+/// Committing threads which arrive while other one writes are batched into its next write and fsync.
+class WriteAheadLog {
+public:
+    /// @brief Open or create log, torn record at its end is cut off
+    /// @param path Path of log file
+    /// @param policy When log is forced to disk
+    /// @param syncInterval Time between fsyncs of SyncPolicy::Interval
+    /// @param initialLsn LSN at start of log if it is created
+    WriteAheadLog(std::filesystem::path path, SyncPolicy policy = SyncPolicy::Always,
+                  std::chrono::milliseconds syncInterval = std::chrono::milliseconds(100), uint64_t initialLsn = 0);
+
+    /// @brief Sync written records and close log
+    ~WriteAheadLog();
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    /// @brief Read records present in log
+    /// @return Records in order of commit
+    std::vector<WalRecord> read() const;
+
+    /// @brief Log saved documents
+    /// @param collection Name of collection
+    /// @param docs Documents with ids
+    /// @return LSN of last record, durable according to sync policy
+    uint64_t logPuts(const std::string& collection, const std::vector<const Document*>& docs);
+
+    /// @brief Log removed documents
+    /// @param collection Name of collection
+    /// @param ids Ids of removed documents
+    /// @return LSN of last record, durable according to sync policy
+    uint64_t logRemoves(const std::string& collection, const std::vector<size_t>& ids);
+
+    /// @brief Drop all records, once their mutations are saved elsewhere
+    void reset();
+
+    /// @brief Get LSN of last committed record
+    /// @return LSN
+    uint64_t getLsn();
+
+    /// @brief Get size of log file
+    /// @return Size in bytes
+    uint64_t size();
+
+private:
+    /// @brief Magic starting log file
+    static constexpr std::string_view magic{"DWAL"};
+
+    /// @brief Size of file header
+    static constexpr size_t headerSize{12};
+
+    /// @brief Path of log file
+    std::filesystem::path _path;
+
+    /// @brief When log is forced to disk
+    SyncPolicy _policy;
+
+    /// @brief Time between fsyncs of SyncPolicy::Interval
+    std::chrono::milliseconds _syncInterval;
+
+    /// @brief Descriptor of log file opened for appending
+    int _fd{-1};
+
+    /// @brief LSN at start of log file
+    uint64_t _base{0};
+
+    /// @brief Mutex guarding state below
+    std::mutex _mutex;
+
+    /// @brief Signals finished write or stopping
+    std::condition_variable _condition;
+
+    /// @brief Records committed but not yet written
+    std::string _pending;
+
+    /// @brief LSN of last committed record
+    uint64_t _committed{0};
+
+    /// @brief LSN of last written record
+    uint64_t _written{0};
+
+    /// @brief LSN of last fsynced record
+    uint64_t _synced{0};
+
+    /// @brief True while one of committing threads writes
+    bool _writing{false};
+
+    /// @brief True after write failed, log accepts no more records
+    bool _failed{false};
+
+    /// @brief True if log is being destroyed
+    bool _stopping{false};
+
+    /// @brief Thread of SyncPolicy::Interval
+    std::thread _syncThread;
+
+    /// @brief Append encoded records and wait until they are durable according to sync policy
+    /// @param records Encoded records
+    /// @return LSN of last record
+    uint64_t commit(const std::string& records);
+
+    /// @brief Append encoded record
+    /// @param type Kind of mutation
+    /// @param collection Name of collection
+    /// @param id Document's id
+    /// @param doc Saved document, nullptr for removal
+    /// @param out Buffer to append to
+    static void encodeRecord(WalRecord::Type type, const std::string& collection, size_t id, const Document* doc, std::string& out);
+
+    /// @brief Write whole buffer to log file
+    /// @param data Data to write
+    void writeAll(std::string_view data);
+
+    /// @brief Force written data to disk
+    void sync();
+
+    /// @brief Loop of thread of SyncPolicy::Interval
+    void syncPeriodically();
+};
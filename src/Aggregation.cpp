@@ -0,0 +1,206 @@
+#include "Aggregation.hpp"
+
+namespace {
+
+/// @brief Convert numeric value to double
+/// @param value Value of field
+/// @return Value as double, std::nullopt if value is not numeric
+std::optional<double> toDouble(const Document::Value& value) {
+    if(const auto* intType = std::get_if<int>(&value)) {
+        return static_cast<double>(*intType);
+    }
+    if(const auto* sizeType = std::get_if<size_t>(&value)) {
+        return static_cast<double>(*sizeType);
+    }
+    if(const auto* doubleType = std::get_if<double>(&value)) {
+        return *doubleType;
+    }
+
+    return std::nullopt;
+}
+
+/// @brief Keep smaller or larger of values
+/// @param current Currently kept value
+/// @param value Candidate value
+/// @param sign -1 to keep smaller value, 1 to keep larger
+void keepExtreme(std::optional<Document::Value>& current, const Document::Value& value, int sign) {
+    if(!current || ValueComparator::order(value, *current) * sign > 0) {
+        current = value;
+    }
+}
+
+}
+
+Aggregation& Aggregation::groupBy(std::string field) {
+    _groupField = std::move(field);
+    return *this;
+}
+
+Aggregation& Aggregation::count(std::string name) {
+    _accumulations.push_back({std::move(name), Accumulator::Count, {}});
+    return *this;
+}
+
+Aggregation& Aggregation::sum(std::string name, std::string field) {
+    _accumulations.push_back({std::move(name), Accumulator::Sum, std::move(field)});
+    return *this;
+}
+
+Aggregation& Aggregation::min(std::string name, std::string field) {
+    _accumulations.push_back({std::move(name), Accumulator::Min, std::move(field)});
+    return *this;
+}
+
+Aggregation& Aggregation::max(std::string name, std::string field) {
+    _accumulations.push_back({std::move(name), Accumulator::Max, std::move(field)});
+    return *this;
+}
+
+Aggregation& Aggregation::avg(std::string name, std::string field) {
+    _accumulations.push_back({std::move(name), Accumulator::Avg, std::move(field)});
+    return *this;
+}
+
+void AggregationState::add(const Document& doc) {
+    const auto& data = doc.getDataView();
+
+    const Document::Value* key{nullptr};
+    if(const auto& groupField = _aggregation->getGroupField()) {
+        auto it = data.find(*groupField);
+        key = it != data.end() ? &it->second : nullptr;
+    }
+
+    auto& current = group(key);
+    ++current.count;
+
+    const auto& accumulations = _aggregation->getAccumulations();
+    for(size_t i{0}; i < accumulations.size(); ++i) {
+        const auto& accumulation = accumulations[i];
+        if(accumulation.accumulator == Accumulator::Count) {
+            continue;
+        }
+
+        auto it = data.find(accumulation.field);
+        if(it == data.end()) {
+            continue;
+        }
+
+        auto& accumulated = current.accumulated[i];
+        switch(accumulation.accumulator) {
+            case Accumulator::Sum:
+            case Accumulator::Avg:
+                if(auto number = toDouble(it->second)) {
+                    ++accumulated.count;
+                    accumulated.sum += *number;
+                }
+                break;
+            case Accumulator::Min:
+                if(ValueComparator::isOrderable(it->second)) {
+                    keepExtreme(accumulated.min, it->second, -1);
+                }
+                break;
+            case Accumulator::Max:
+                if(ValueComparator::isOrderable(it->second)) {
+                    keepExtreme(accumulated.max, it->second, 1);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void AggregationState::merge(const AggregationState& other) {
+    for(const auto& otherGroup : other._groups) {
+        auto& current = group(otherGroup.key ? &*otherGroup.key : nullptr);
+        current.count += otherGroup.count;
+
+        for(size_t i{0}; i < current.accumulated.size(); ++i) {
+            auto& accumulated = current.accumulated[i];
+            const auto& otherAccumulated = otherGroup.accumulated[i];
+
+            accumulated.count += otherAccumulated.count;
+            accumulated.sum += otherAccumulated.sum;
+            if(otherAccumulated.min) {
+                keepExtreme(accumulated.min, *otherAccumulated.min, -1);
+            }
+            if(otherAccumulated.max) {
+                keepExtreme(accumulated.max, *otherAccumulated.max, 1);
+            }
+        }
+    }
+}
+
+std::vector<Document> AggregationState::results() const {
+    std::vector<Document> results;
+    results.reserve(_groups.size());
+
+    const auto& accumulations = _aggregation->getAccumulations();
+    for(const auto& current : _groups) {
+        Document result;
+        auto& data = result.getData();
+
+        if(current.key) {
+            data.emplace(*_aggregation->getGroupField(), *current.key);
+        }
+
+        for(size_t i{0}; i < accumulations.size(); ++i) {
+            const auto& accumulated = current.accumulated[i];
+            const auto& name = accumulations[i].name;
+
+            switch(accumulations[i].accumulator) {
+                case Accumulator::Count:
+                    data[name] = current.count;
+                    break;
+                case Accumulator::Sum:
+                    data[name] = accumulated.sum;
+                    break;
+                case Accumulator::Avg:
+                    if(accumulated.count > 0) {
+                        data[name] = accumulated.sum / static_cast<double>(accumulated.count);
+                    }
+                    break;
+                case Accumulator::Min:
+                    if(accumulated.min) {
+                        data[name] = *accumulated.min;
+                    }
+                    break;
+                case Accumulator::Max:
+                    if(accumulated.max) {
+                        data[name] = *accumulated.max;
+                    }
+                    break;
+            }
+        }
+
+        results.push_back(std::move(result));
+    }
+
+    return results;
+}
+
+AggregationState::Group& AggregationState::group(const Document::Value* key) {
+    size_t position = _groups.size();
+
+    if(!key) {
+        if(_missingPosition) {
+            return _groups[*_missingPosition];
+        }
+        _missingPosition = position;
+    }
+    else {
+        auto [it, inserted] = _positions.try_emplace(*key, position);
+        if(!inserted) {
+            return _groups[it->second];
+        }
+    }
+
+    Group created;
+    if(key) {
+        created.key = *key;
+    }
+    created.accumulated.resize(_aggregation->getAccumulations().size());
+
+    _groups.push_back(std::move(created));
+    return _groups.back();
+}
@@ -0,0 +1,204 @@
+#include "BinaryCodec.hpp"
+
+#include <cstring>
+
+void BinaryCodec::encode(const Document& doc, std::string& out) {
+    out.append(header);
+    encodeBody(doc, out);
+}
+
+Document BinaryCodec::decode(std::string_view data) {
+    if(!isEncoded(data)) {
+        throw std::runtime_error("Data is not binary encoded document.");
+    }
+
+    Reader reader{data, header.size()};
+    auto doc = decodeBody(reader);
+
+    if(reader.pos != data.size()) {
+        throw std::runtime_error("Unexpected data after binary encoded document.");
+    }
+
+    return doc;
+}
+
+bool BinaryCodec::isEncoded(std::string_view data) {
+    return data.substr(0, header.size()) == header;
+}
+
+uint32_t BinaryCodec::checksum(std::string_view data, uint32_t seed) {
+    uint32_t hash{seed};
+    for(char c : data) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void BinaryCodec::encodeBody(const Document& doc, std::string& out) {
+    const auto& data = doc.getDataView();
+    writeVarint(data.size(), out);
+
+    for(const auto& [key, value] : data) {
+        writeString(key, out);
+        encodeValue(value, out);
+    }
+}
+
+void BinaryCodec::encodeValue(const Document::Value& value, std::string& out) {
+    out.push_back(static_cast<char>(value.index()));
+
+    if(const auto* intType = std::get_if<int>(&value)) {
+        writeFixed(static_cast<uint32_t>(*intType), 4, out);
+    }
+    else if(const auto* sizeType = std::get_if<size_t>(&value)) {
+        writeFixed(*sizeType, 8, out);
+    }
+    else if(const auto* doubleType = std::get_if<double>(&value)) {
+        uint64_t bits;
+        std::memcpy(&bits, doubleType, sizeof(bits));
+        writeFixed(bits, 8, out);
+    }
+    else if(const auto* stringType = std::get_if<std::string>(&value)) {
+        writeString(*stringType, out);
+    }
+    else if(const auto* boolType = std::get_if<bool>(&value)) {
+        out.push_back(*boolType ? 1 : 0);
+    }
+    else if(const auto* documentType = std::get_if<Document>(&value)) {
+        encodeBody(*documentType, out);
+    }
+    else if(const auto* vectorType = std::get_if<Document::Vector>(&value)) {
+        writeVarint(vectorType->size(), out);
+        for(const auto& doc : *vectorType) {
+            encodeBody(doc, out);
+        }
+    }
+    else if(const auto* mapType = std::get_if<Document::Map>(&value)) {
+        writeVarint(mapType->size(), out);
+        for(const auto& [key, doc] : *mapType) {
+            writeString(key, out);
+            encodeBody(doc, out);
+        }
+    }
+}
+
+void BinaryCodec::writeVarint(uint64_t value, std::string& out) {
+    while(value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void BinaryCodec::writeFixed(uint64_t value, size_t bytes, std::string& out) {
+    for(size_t i{0}; i < bytes; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
+void BinaryCodec::writeString(std::string_view value, std::string& out) {
+    writeVarint(value.size(), out);
+    out.append(value);
+}
+
+Document BinaryCodec::decodeBody(Reader& reader) {
+    Document doc;
+    auto& data = doc.getData();
+
+    auto count = reader.varint();
+    for(uint64_t i{0}; i < count; ++i) {
+        auto key = reader.string();
+        data.emplace(std::string(key), decodeValue(reader));
+    }
+
+    return doc;
+}
+
+Document::Value BinaryCodec::decodeValue(Reader& reader) {
+    switch(static_cast<Tag>(reader.byte())) {
+        case Tag::Int:
+            return static_cast<int>(static_cast<uint32_t>(reader.fixed(4)));
+        case Tag::SizeT:
+            return static_cast<size_t>(reader.fixed(8));
+        case Tag::Double: {
+            uint64_t bits = reader.fixed(8);
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+        case Tag::String:
+            return std::string(reader.string());
+        case Tag::Bool:
+            return reader.byte() != 0;
+        case Tag::Document:
+            return decodeBody(reader);
+        case Tag::Vector: {
+            Document::Vector vector;
+            auto count = reader.varint();
+            for(uint64_t i{0}; i < count; ++i) {
+                vector.push_back(decodeBody(reader));
+            }
+            return vector;
+        }
+        case Tag::Map: {
+            Document::Map map;
+            auto count = reader.varint();
+            for(uint64_t i{0}; i < count; ++i) {
+                auto key = reader.string();
+                map.emplace(std::string(key), decodeBody(reader));
+            }
+            return map;
+        }
+    }
+
+    throw std::runtime_error("Unknown type tag in binary encoded document.");
+}
+
+uint8_t BinaryCodec::Reader::byte() {
+    if(pos >= data.size()) {
+        throw std::runtime_error("Truncated binary encoded document.");
+    }
+
+    return static_cast<uint8_t>(data[pos++]);
+}
+
+uint64_t BinaryCodec::Reader::varint() {
+    uint64_t value{0};
+
+    for(unsigned shift{0}; shift < 64; shift += 7) {
+        auto current = byte();
+        value |= static_cast<uint64_t>(current & 0x7f) << shift;
+        if((current & 0x80) == 0) {
+            return value;
+        }
+    }
+
+    throw std::runtime_error("Malformed varint in binary encoded document.");
+}
+
+uint64_t BinaryCodec::Reader::fixed(size_t bytes) {
+    if(data.size() - pos < bytes) {
+        throw std::runtime_error("Truncated binary encoded document.");
+    }
+
+    uint64_t value{0};
+    for(size_t i{0}; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(data[pos + i])) << (8 * i);
+    }
+    pos += bytes;
+
+    return value;
+}
+
+std::string_view BinaryCodec::Reader::string() {
+    auto size = varint();
+    if(data.size() - pos < size) {
+        throw std::runtime_error("Truncated binary encoded document.");
+    }
+
+    auto value = data.substr(pos, size);
+    pos += size;
+
+    return value;
+}
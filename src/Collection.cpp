@@ -2,26 +2,71 @@
 
 void Collection::insert(Document& doc) {
     try {
-        auto optId = doc.get<size_t>("id");
-        if (optId && _ids.find(*optId) != _ids.end()) {
-            Logger::logWarning("Document with id " + std::to_string(*optId) + " already exists in collection: " + _name + ".");
+        auto id = prepareInsert(doc);
+        if (!id) {
+            Logger::logWarning("Document with id " + std::to_string(*doc.get<size_t>("id")) + " already exists in collection: " + _name + ".");
             return;
         }
 
-        auto id = optId.value_or(generateId());
-        doc.set("id", id);
-        
-        _ids.insert(id);
-        fillDocumentWithIds(doc);
-        _documents.push_back(doc);
+        store(Document(doc), *id);
 
-        Logger::logInfo("Added document of id: " + std::to_string(id) + " in collection: " + _name + ".");
+        Logger::logInfo("Added document of id: " + std::to_string(*id) + " in collection: " + _name + ".");
     }
     catch(const std::runtime_error& e) {
         Logger::logError(e.what());
     }
 }
 
+std::optional<size_t> Collection::insert(Document&& doc) {
+    try {
+        auto id = prepareInsert(doc);
+        if (!id) {
+            Logger::logWarning("Document with id " + std::to_string(*doc.get<size_t>("id")) + " already exists in collection: " + _name + ".");
+            return std::nullopt;
+        }
+
+        store(std::move(doc), *id);
+
+        Logger::logInfo("Added document of id: " + std::to_string(*id) + " in collection: " + _name + ".");
+        return id;
+    }
+    catch(const std::runtime_error& e) {
+        Logger::logError(e.what());
+        return std::nullopt;
+    }
+}
+
+std::vector<size_t> Collection::insertMany(std::vector<Document> docs) {
+    std::vector<size_t> insertedIds;
+    insertedIds.reserve(docs.size());
+
+    _documents.reserve(_documents.size() + docs.size());
+    _ids.reserve(_ids.size() + docs.size());
+    _handles.reserve(_handles.size() + docs.size());
+
+    for(auto& doc : docs) {
+        try {
+            auto id = prepareInsert(doc);
+            if(!id) {
+                continue;
+            }
+
+            store(std::move(doc), *id);
+            insertedIds.push_back(*id);
+        }
+        catch(const std::runtime_error& e) {
+            Logger::logError(e.what());
+        }
+    }
+
+    if(insertedIds.size() != docs.size()) {
+        Logger::logWarning("Skipped " + std::to_string(docs.size() - insertedIds.size()) + " document(s) in collection: " + _name + ".");
+    }
+    Logger::logInfo("Added " + std::to_string(insertedIds.size()) + " document(s) in collection: " + _name + ".");
+
+    return insertedIds;
+}
+
 void Collection::update(Document& newDoc) {
     auto idOpt = newDoc.get<size_t>("id");
     if (!idOpt) {
@@ -31,21 +76,18 @@ void Collection::update(Document& newDoc) {
 
     size_t id = *idOpt;
 
-    for (size_t pos = 0; pos < _documents.size(); ++pos) {
-        auto& currentDoc = _documents[pos];
-
-        auto currentIdOpt = currentDoc.get<size_t>("id");
-        if (!currentIdOpt || *currentIdOpt != id) {
-            continue;
-        }
-
-        currentDoc = newDoc;
-
-        Logger::logInfo("Updated document of id: " + std::to_string(id) + " in collection: " + _name + ".");
+    auto handle = getHandle(id);
+    if (!handle) {
+        Logger::logWarning("No document with id " + std::to_string(id) + " found to update in collection: " + _name + ".");
         return;
     }
 
-    Logger::logWarning("No document with id " + std::to_string(id) + " found to update in collection: " + _name + ".");
+    auto& stored = *_documents.get(*handle);
+    unindexDocument(stored, *handle);
+    stored = newDoc;
+    indexDocument(stored, *handle);
+
+    Logger::logInfo("Updated document of id: " + std::to_string(id) + " in collection: " + _name + ".");
 }
 
 void Collection::remove(Document& doc) {
@@ -58,43 +100,473 @@ void Collection::remove(Document& doc) {
     auto id = *idOpt;
     _ids.erase(id);
 
-    auto it = std::find_if(_documents.begin(), _documents.end(),
-        [id](const Document& d) {
-            auto dId = d.get<size_t>("id");
-            return dId && *dId == id;
-        });
-
-    if (it == _documents.end()) {
+    auto handle = getHandle(id);
+    if (!handle) {
         Logger::logWarning("Tried to remove non-existing document of id: " + std::to_string(id) + " in collection:" + _name + ".");
         return;
     }
 
-    _documents.erase(it);
+    unindexDocument(*_documents.get(*handle), *handle);
+
+    // Last document is moved into the freed position, its handle stays valid
+    _documents.erase(*handle);
+    _handles.erase(id);
 
     Logger::logInfo("Removed document of id: " + std::to_string(id) + " in collection: " + _name + ".");
 }
 
 std::optional<Document> Collection::getDocumentById(size_t id) {
+    auto handle = getHandle(id);
+    if(handle) {
+        return *_documents.get(*handle);
+    }
+
+    return std::nullopt;
+}
+
+std::optional<SlotHandle> Collection::getHandle(size_t id) const {
+    auto it = _handles.find(id);
+    if(it != _handles.end()) {
+        return it->second;
+    }
+
+    return std::nullopt;
+}
+
+std::vector<Document> Collection::findEqual(const std::string& field, const Document::Value& value) const {
+    std::vector<Document> results;
+
+    auto index = _hashIndexes.find(field);
+    if(index != _hashIndexes.end()) {
+        const auto* handles = index->second.find(value);
+        if(!handles) {
+            return results;
+        }
+
+        // Postings are unordered, documents are returned in collection order as scan returns them
+        std::vector<size_t> positions;
+        positions.reserve(handles->size());
+        for(auto handle : *handles) {
+            if(auto pos = _documents.position(handle)) {
+                positions.push_back(*pos);
+            }
+        }
+        std::sort(positions.begin(), positions.end());
+
+        results.reserve(positions.size());
+        for(auto pos : positions) {
+            results.push_back(_documents[pos]);
+        }
+
+        return results;
+    }
+
     for(const auto& doc : _documents) {
-        auto idOpt = doc.get<size_t>("id");
-        if(idOpt && *idOpt == id) {
-            return doc;
+        const auto& data = doc.getDataView();
+        auto it = data.find(field);
+        if(it != data.end() && ValueComparator::equal(it->second, value)) {
+            results.push_back(doc);
         }
     }
 
-    return std::nullopt;
+    return results;
 }
 
-size_t Collection::generateId() {
-    auto maxIterations{100};
-    for(auto i{0}; i < maxIterations; ++i) {
-        auto id = _rng();
-        if(_ids.find(id) == _ids.end()) {
-            return id;
+std::vector<Document> Collection::findRange(const std::string& field, const std::optional<Bound>& lower, const std::optional<Bound>& upper) const {
+    auto index = _orderedIndexes.find(field);
+    if(index != _orderedIndexes.end()) {
+        return collectDocuments(index->second.range(lower, upper), field);
+    }
+
+    std::vector<std::pair<const Document::Value*, size_t>> matches;
+    for(size_t pos{0}; pos < _documents.size(); ++pos) {
+        const auto& data = _documents[pos].getDataView();
+        auto it = data.find(field);
+        if(it != data.end() && OrderedIndex::inRange(it->second, lower, upper)) {
+            matches.emplace_back(&it->second, pos);
+        }
+    }
+
+    std::stable_sort(matches.begin(), matches.end(), [](const auto& lhs, const auto& rhs) {
+        return ValueComparator::order(*lhs.first, *rhs.first) < 0;
+    });
+
+    std::vector<Document> results;
+    results.reserve(matches.size());
+    for(const auto& [value, pos] : matches) {
+        results.push_back(_documents[pos]);
+    }
+
+    return results;
+}
+
+std::vector<Document> Collection::findPrefix(const std::string& field, const std::string& prefix) const {
+    auto index = _orderedIndexes.find(field);
+    if(index != _orderedIndexes.end()) {
+        return collectDocuments(index->second.prefix(prefix), field);
+    }
+
+    std::vector<std::pair<const std::string*, size_t>> matches;
+    for(size_t pos{0}; pos < _documents.size(); ++pos) {
+        const auto& data = _documents[pos].getDataView();
+        auto it = data.find(field);
+        if(it == data.end()) {
+            continue;
+        }
+
+        const auto* value = std::get_if<std::string>(&it->second);
+        if(value && value->compare(0, prefix.size(), prefix) == 0) {
+            matches.emplace_back(value, pos);
+        }
+    }
+
+    std::stable_sort(matches.begin(), matches.end(), [](const auto& lhs, const auto& rhs) {
+        return *lhs.first < *rhs.first;
+    });
+
+    std::vector<Document> results;
+    results.reserve(matches.size());
+    for(const auto& [value, pos] : matches) {
+        results.push_back(_documents[pos]);
+    }
+
+    return results;
+}
+
+void Collection::createIndex(const std::string& field, IndexType type) {
+    if(hasIndex(field, type)) {
+        Logger::logWarning("Index over field: " + field + " already exists in collection: " + _name + ".");
+        return;
+    }
+
+    if(type == IndexType::Hash) {
+        auto [it, inserted] = _hashIndexes.emplace(field, HashIndex(field));
+        for(size_t pos{0}; pos < _documents.size(); ++pos) {
+            it->second.insert(_documents[pos], _documents.handleAt(pos));
         }
     }
+    else {
+        auto [it, inserted] = _orderedIndexes.emplace(field, OrderedIndex(field));
+        for(size_t pos{0}; pos < _documents.size(); ++pos) {
+            it->second.insert(_documents[pos], _documents.handleAt(pos));
+        }
+    }
+
+    Logger::logInfo("Created index over field: " + field + " in collection: " + _name + ".");
+}
 
-    throw std::runtime_error("Failed to generate unique document ID after " + std::to_string(maxIterations) + " attempts.");
+void Collection::dropIndex(const std::string& field) {
+    if(_hashIndexes.erase(field) + _orderedIndexes.erase(field) == 0) {
+        Logger::logWarning("Tried to drop non existing index over field: " + field + " in collection: " + _name + ".");
+    }
+}
+
+bool Collection::hasIndex(const std::string& field, IndexType type) const {
+    if(type == IndexType::Hash) {
+        return _hashIndexes.find(field) != _hashIndexes.end();
+    }
+
+    return _orderedIndexes.find(field) != _orderedIndexes.end();
+}
+
+std::vector<std::pair<std::string, IndexType>> Collection::getIndexes() const {
+    std::vector<std::pair<std::string, IndexType>> indexes;
+    indexes.reserve(_hashIndexes.size() + _orderedIndexes.size());
+
+    for(const auto& [field, index] : _hashIndexes) {
+        indexes.emplace_back(field, IndexType::Hash);
+    }
+    for(const auto& [field, index] : _orderedIndexes) {
+        indexes.emplace_back(field, IndexType::Ordered);
+    }
+
+    return indexes;
+}
+
+QueryPlan Collection::planQuery(std::vector<Predicate> predicates, bool complete) const {
+    QueryPlan plan;
+    plan.complete = complete;
+
+    size_t size = _documents.size();
+    auto scanLimit = static_cast<size_t>(static_cast<double>(size) * scanThreshold);
+
+    // Every access path remembers which predicates it answers exactly
+    std::vector<std::pair<AccessPath, std::vector<size_t>>> paths;
+
+    for(size_t i{0}; i < predicates.size(); ++i) {
+        const auto& predicate = predicates[i];
+        auto index = _hashIndexes.find(predicate.field);
+        if(predicate.op != Operator::Equal || index == _hashIndexes.end() || !ValueComparator::isScalar(predicate.value)) {
+            continue;
+        }
+
+        AccessPath path{IndexType::Hash, predicate.field, predicate.value, std::nullopt, std::nullopt, 0};
+        const auto* handles = index->second.find(predicate.value);
+        path.estimated = handles ? handles->size() : 0;
+        paths.emplace_back(std::move(path), std::vector<size_t>{i});
+    }
+
+    for(const auto& [field, index] : _orderedIndexes) {
+        AccessPath path{IndexType::Ordered, field, std::nullopt, std::nullopt, std::nullopt, 0};
+        std::vector<size_t> covered;
+        bool numeric{false};
+        bool mixed{false};
+
+        for(size_t i{0}; i < predicates.size(); ++i) {
+            const auto& predicate = predicates[i];
+            if(predicate.field != field || predicate.op == Operator::NotEqual || !ValueComparator::isOrderable(predicate.value)) {
+                continue;
+            }
+
+            if(covered.empty()) {
+                numeric = ValueComparator::isNumeric(predicate.value);
+            }
+            mixed = mixed || ValueComparator::isNumeric(predicate.value) != numeric;
+            covered.push_back(i);
+
+            bool inclusive = predicate.op != Operator::Greater && predicate.op != Operator::Less;
+            if(predicate.op != Operator::Less && predicate.op != Operator::LessEqual) {
+                int result = path.lower ? ValueComparator::order(predicate.value, path.lower->value) : 1;
+                if(result > 0 || (result == 0 && !inclusive)) {
+                    path.lower = Bound{predicate.value, inclusive};
+                }
+            }
+            if(predicate.op != Operator::Greater && predicate.op != Operator::GreaterEqual) {
+                int result = path.upper ? ValueComparator::order(predicate.value, path.upper->value) : -1;
+                if(result < 0 || (result == 0 && !inclusive)) {
+                    path.upper = Bound{predicate.value, inclusive};
+                }
+            }
+        }
+
+        // Bounds of different kinds can not be merged into one range
+        if(covered.empty() || mixed) {
+            continue;
+        }
+
+        path.estimated = index.count(path.lower, path.upper, scanLimit);
+        paths.emplace_back(std::move(path), std::move(covered));
+    }
+
+    std::stable_sort(paths.begin(), paths.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first.estimated < rhs.first.estimated;
+    });
+
+    std::vector<bool> isCovered(predicates.size(), false);
+
+    if(paths.empty() || paths.front().first.estimated > scanLimit) {
+        plan.estimatedScanned = size;
+    }
+    else {
+        plan.estimatedScanned = paths.front().first.estimated;
+
+        for(auto& [path, covered] : paths) {
+            bool answersNew = std::any_of(covered.begin(), covered.end(), [&](size_t i) { return !isCovered[i]; });
+            bool cheap = plan.accessPaths.empty() || path.estimated <= plan.estimatedScanned * intersectFactor;
+            if(!answersNew || !cheap) {
+                continue;
+            }
+
+            for(auto i : covered) {
+                isCovered[i] = true;
+            }
+            plan.estimatedScanned = std::min(plan.estimatedScanned, path.estimated);
+            plan.accessPaths.push_back(std::move(path));
+        }
+    }
+
+    std::vector<std::pair<size_t, Predicate>> residual;
+    for(size_t i{0}; i < predicates.size(); ++i) {
+        if(!isCovered[i]) {
+            residual.emplace_back(estimateMatches(predicates[i]), std::move(predicates[i]));
+        }
+    }
+
+    // Most selective predicates are checked first, so most candidates are rejected early
+    std::stable_sort(residual.begin(), residual.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    for(auto& [estimate, predicate] : residual) {
+        plan.residual.push_back(std::move(predicate));
+    }
+
+    return plan;
+}
+
+size_t Collection::estimateMatches(const Predicate& predicate) const {
+    size_t size = _documents.size();
+
+    if(predicate.op == Operator::Equal) {
+        auto index = _hashIndexes.find(predicate.field);
+        if(index != _hashIndexes.end()) {
+            const auto* handles = index->second.find(predicate.value);
+            return handles ? handles->size() : 0;
+        }
+    }
+
+    if(predicate.op != Operator::NotEqual && ValueComparator::isOrderable(predicate.value)) {
+        auto index = _orderedIndexes.find(predicate.field);
+        if(index != _orderedIndexes.end()) {
+            bool inclusive = predicate.op != Operator::Greater && predicate.op != Operator::Less;
+            std::optional<Bound> lower;
+            std::optional<Bound> upper;
+            if(predicate.op != Operator::Less && predicate.op != Operator::LessEqual) {
+                lower = Bound{predicate.value, inclusive};
+            }
+            if(predicate.op != Operator::Greater && predicate.op != Operator::GreaterEqual) {
+                upper = Bound{predicate.value, inclusive};
+            }
+            return index->second.count(lower, upper, size);
+        }
+    }
+
+    // Without statistics equality is assumed to be more selective than range
+    switch(predicate.op) {
+        case Operator::Equal:
+            return size / 10;
+        case Operator::NotEqual:
+            return size;
+        default:
+            return size / 3;
+    }
+}
+
+std::vector<size_t> Collection::candidatePositions(const QueryPlan& plan) const {
+    auto lookup = [&](const AccessPath& path) {
+        if(path.type == IndexType::Hash) {
+            const auto* handles = _hashIndexes.at(path.field).find(*path.value);
+            return handles ? std::vector<SlotHandle>(handles->begin(), handles->end()) : std::vector<SlotHandle>();
+        }
+        return _orderedIndexes.at(path.field).range(path.lower, path.upper);
+    };
+
+    auto handles = lookup(plan.accessPaths.front());
+
+    for(size_t i{1}; i < plan.accessPaths.size() && !handles.empty(); ++i) {
+        auto other = lookup(plan.accessPaths[i]);
+        std::unordered_set<SlotHandle, SlotHandleHash> otherHandles(other.begin(), other.end());
+
+        handles.erase(std::remove_if(handles.begin(), handles.end(), [&](SlotHandle handle) {
+            return otherHandles.find(handle) == otherHandles.end();
+        }), handles.end());
+    }
+
+    std::vector<size_t> positions;
+    positions.reserve(handles.size());
+    for(auto handle : handles) {
+        if(auto pos = _documents.position(handle)) {
+            positions.push_back(*pos);
+        }
+    }
+
+    std::sort(positions.begin(), positions.end());
+    return positions;
+}
+
+size_t Collection::partitionCount(size_t count) {
+    // Several partitions per worker let idle threads take over work of slow ones
+    size_t partitions = std::min(ThreadPool::shared().size() * 4, count / minPartitionSize);
+    return std::max<size_t>(partitions, 1);
+}
+
+int Collection::compareSortKeys(const Document& lhs, const Document& rhs, const SortKey& key) {
+    auto sortValue = [&key](const Document& doc) -> const Document::Value* {
+        const auto& data = doc.getDataView();
+        auto it = data.find(key.field);
+        return it != data.end() && ValueComparator::isOrderable(it->second) ? &it->second : nullptr;
+    };
+
+    const auto* lhsValue = sortValue(lhs);
+    const auto* rhsValue = sortValue(rhs);
+
+    // Documents without orderable value go last in both directions
+    if(!lhsValue || !rhsValue) {
+        return static_cast<int>(lhsValue == nullptr) - static_cast<int>(rhsValue == nullptr);
+    }
+
+    int result = ValueComparator::order(*lhsValue, *rhsValue);
+    return key.ascending ? result : -result;
+}
+
+std::vector<Document> Collection::collectDocuments(const std::vector<SlotHandle>& handles, const std::string& field) const {
+    std::vector<std::pair<const Document::Value*, size_t>> matches;
+    matches.reserve(handles.size());
+    for(auto handle : handles) {
+        if(auto pos = _documents.position(handle)) {
+            matches.emplace_back(&_documents[*pos].getDataView().at(field), *pos);
+        }
+    }
+
+    // Handles come ordered by key, but postings of one key are unordered, so documents tying on key are put in
+    // collection order as scan returns them
+    for(size_t first{0}; first < matches.size();) {
+        size_t last{first + 1};
+        while(last < matches.size() && ValueComparator::order(*matches[first].first, *matches[last].first) == 0) {
+            ++last;
+        }
+
+        std::sort(matches.begin() + first, matches.begin() + last, [](const auto& lhs, const auto& rhs) {
+            return lhs.second < rhs.second;
+        });
+        first = last;
+    }
+
+    std::vector<Document> results;
+    results.reserve(matches.size());
+    for(const auto& [value, pos] : matches) {
+        results.push_back(_documents[pos]);
+    }
+
+    return results;
+}
+
+void Collection::indexDocument(const Document& doc, SlotHandle handle) {
+    for(auto& [field, index] : _hashIndexes) {
+        index.insert(doc, handle);
+    }
+
+    for(auto& [field, index] : _orderedIndexes) {
+        index.insert(doc, handle);
+    }
+}
+
+void Collection::unindexDocument(const Document& doc, SlotHandle handle) {
+    for(auto& [field, index] : _hashIndexes) {
+        index.remove(doc, handle);
+    }
+
+    for(auto& [field, index] : _orderedIndexes) {
+        index.remove(doc, handle);
+    }
+}
+
+std::optional<size_t> Collection::prepareInsert(Document& doc) {
+    auto optId = doc.get<size_t>("id");
+    if(optId && _ids.find(*optId) != _ids.end()) {
+        return std::nullopt;
+    }
+
+    auto id = optId ? *optId : generateId();
+    doc.set("id", id);
+
+    _ids.insert(id);
+    _idGenerator.observe(id);
+    fillDocumentWithIds(doc);
+
+    return id;
+}
+
+SlotHandle Collection::store(Document&& doc, size_t id) {
+    auto handle = _documents.insert(std::move(doc));
+    _handles.emplace(id, handle);
+    indexDocument(*_documents.get(handle), handle);
+
+    return handle;
+}
+
+size_t Collection::generateId() {
+    return _idGenerator.next(_ids);
 }
 
 void Collection::fillDocumentWithIds(Document& doc) {
@@ -0,0 +1,67 @@
+#include "Compactor.hpp"
+
+#include "Logger.hpp"
+
+#include <algorithm>
+
+Compactor::Compactor(CompactionOptions options) : _options(options) {
+    if(_options.enabled) {
+        _thread = std::thread([this]() { run(); });
+    }
+}
+
+Compactor::~Compactor() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+
+    _stop.notify_all();
+    if(_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void Compactor::track(const std::shared_ptr<SegmentStore>& store) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _stores.erase(std::remove_if(_stores.begin(), _stores.end(), [](const auto& tracked) { return tracked.expired(); }), _stores.end());
+    _stores.push_back(store);
+}
+
+size_t Compactor::compact() {
+    std::vector<std::shared_ptr<SegmentStore>> stores;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for(const auto& tracked : _stores) {
+            if(auto store = tracked.lock()) {
+                stores.push_back(std::move(store));
+            }
+        }
+    }
+
+    size_t compacted{0};
+    for(const auto& store : stores) {
+        try {
+            compacted += store->compact(_options.deadRatio, _options.bytesPerSecond);
+        }
+        catch(const std::exception& e) {
+            Logger::logError("Compaction failed: " + std::string(e.what()) + ".");
+        }
+    }
+
+    return compacted;
+}
+
+void Compactor::run() {
+    for(;;) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if(_stop.wait_for(lock, _options.interval, [this]() { return _stopping; })) {
+                return;
+            }
+        }
+
+        compact();
+    }
+}
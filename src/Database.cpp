@@ -1,62 +1,399 @@
 #include "Database.hpp"
 
-Database::Database(std::string path) : _path(std::move(path)) {
+#include "FileSync.hpp"
+
+Database::Database(std::string path, DatabaseOptions options) : _path(std::move(path)), _options(options), _storage(options.storageFormat, options.compaction) {
     _name = _path.substr(_path.find_last_of("/") + 1);
 
     ensureDirectoryExists(static_cast<std::filesystem::path>(_path));
 
+    std::vector<std::filesystem::path> collectionPaths;
     for(const auto& entry : std::filesystem::directory_iterator(_path)) {
-        auto& collectionPath = entry.path();
-
-        if(collectionPath == (_path + "/.DS_Store")) {
+        // Only directories hold collections, files such as write-ahead log or .DS_Store are skipped
+        if(!entry.is_directory()) {
             continue;
         }
 
-        auto collectionPathString = collectionPath.string();
-        auto collectionName = collectionPathString.erase(0, collectionPathString.find_last_of("/") + 1);
+        // Lazily opened database only discovers names, documents are loaded on first access
+        if(_options.lazyLoading) {
+            _unloaded.insert(entry.path().filename().string());
+        }
+        else {
+            collectionPaths.push_back(entry.path());
+        }
+    }
 
-        try {
-            Collection collection(collectionName);
-            for(auto& doc : _storage.loadDocuments(collectionPath)) {
-                collection.insert(doc);
+    // Each collection is loaded into its own slot, results are merged on this thread afterwards
+    std::vector<std::optional<Collection>> collections(collectionPaths.size());
+    std::vector<std::optional<uint64_t>> snapshotLsns(collectionPaths.size());
+    auto load = [&](size_t, size_t begin, size_t end) {
+        for(size_t i{begin}; i < end; ++i) {
+            auto collectionName = collectionPaths[i].filename().string();
+
+            try {
+                Collection collection(collectionName, _options.idStrategy);
+                snapshotLsns[i] = loadCollection(collection, collectionPaths[i]);
+                collections[i].emplace(std::move(collection));
+            } catch (const std::exception& e) {
+                Logger::logError("Failed to load collection '" + collectionName + "': " + e.what() + ".");
+                throw;
             }
+        }
+    };
 
-            auto [iter, inserted] = _collections.try_emplace(collectionName, std::move(collection));
+    auto& pool = ThreadPool::shared();
+    if(_options.loading == Execution::Sequential || collectionPaths.size() < 2) {
+        load(0, 0, collectionPaths.size());
+    }
+    else {
+        pool.parallelFor(collectionPaths.size(), collectionPaths.size(), load);
+    }
 
-            if (!inserted) {
-                throw std::runtime_error("Collection '" + collectionName + "' already exists.");
-            }
-        } catch (const std::exception& e) {
-            Logger::logError("Failed to load collection '" + collectionName + "': " + e.what() + ".");
-            throw;
+    for(size_t i{0}; i < collectionPaths.size(); ++i) {
+        auto collectionName = collections[i]->getName();
+        if(snapshotLsns[i]) {
+            _snapshotLsns[collectionName] = *snapshotLsns[i];
+        }
+
+        auto [iter, inserted] = _collections.try_emplace(collectionName, std::move(*collections[i]));
+
+        if (!inserted) {
+            Logger::logError("Failed to load collection '" + iter->first + "': Collection '" + iter->first + "' already exists.");
+            throw std::runtime_error("Collection '" + iter->first + "' already exists.");
         }
     }
 
+    recover();
+
     Logger::logInfo("Succesfully loaded database: " + _path + ".");
 }
 
 std::optional<std::reference_wrapper<Collection>> Database::getCollection(std::string collectionName) {
-    auto it = _collections.find(std::move(collectionName));
-    if(it != _collections.end()) {
-        return std::ref(it->second);
+    if(auto* collection = findCollection(collectionName)) {
+        // Caller may mutate collection without persisting it, so its state may no longer match disk
+        _exposed.insert(collectionName);
+        return std::ref(*collection);
     }
 
     return std::nullopt;
 }
 
-std::optional<Collection> Database::getCollectionCopy(std::string collectionName) const {
+bool Database::isLoaded(const std::string& collectionName) const {
+    return _collections.find(collectionName) != _collections.end();
+}
+
+bool Database::unloadCollection(const std::string& collectionName) {
+    return releaseCollection(collectionName);
+}
+
+const Collection* Database::findCollection(const std::string& collectionName) const {
     auto it = _collections.find(collectionName);
     if(it == _collections.end()) {
+        auto unloaded = _unloaded.find(collectionName);
+        if(unloaded == _unloaded.end()) {
+            return nullptr;
+        }
+
+        Collection collection(collectionName, _options.idStrategy);
+        try {
+            if(auto lsn = loadCollection(collection, _path + '/' + collectionName)) {
+                _snapshotLsns[collectionName] = *lsn;
+            }
+        } catch (const std::exception& e) {
+            Logger::logError("Failed to load collection '" + collectionName + "': " + e.what() + ".");
+            throw;
+        }
+
+        _unloaded.erase(unloaded);
+        it = _collections.emplace(collectionName, std::move(collection)).first;
+        Logger::logInfo("Loaded collection: " + collectionName + " of database: " + _name + ".");
+    }
+
+    if(_options.maxLoadedCollections > 0) {
+        _lastAccess[collectionName] = ++_accessClock;
+        releaseIdleCollections(collectionName);
+    }
+
+    return &it->second;
+}
+
+Collection* Database::findCollection(const std::string& collectionName) {
+    // Loaded collections are mutable members, so casting constness away is safe
+    return const_cast<Collection*>(static_cast<const Database*>(this)->findCollection(collectionName));
+}
+
+bool Database::releaseCollection(const std::string& collectionName) const {
+    auto it = _collections.find(collectionName);
+    // Collection handed out by getCollection is referenced outside of database, so it must stay in memory
+    if(it == _collections.end() || _dirty.find(collectionName) != _dirty.end() || _exposed.find(collectionName) != _exposed.end()) {
+        return false;
+    }
+
+    // Document files stay as they are, so collection is loaded again from them or from its snapshot
+    _collections.erase(it);
+    _lastAccess.erase(collectionName);
+    _snapshotLsns.erase(collectionName);
+    _unloaded.insert(collectionName);
+
+    return true;
+}
+
+void Database::releaseIdleCollections(const std::string& accessedName) const {
+    while(_collections.size() > _options.maxLoadedCollections) {
+        std::optional<std::string> idlest;
+        uint64_t idlestAccess{0};
+        for(const auto& [collectionName, access] : _lastAccess) {
+            if(collectionName == accessedName || _dirty.find(collectionName) != _dirty.end() || _exposed.find(collectionName) != _exposed.end()) {
+                continue;
+            }
+
+            if(!idlest || access < idlestAccess) {
+                idlest = collectionName;
+                idlestAccess = access;
+            }
+        }
+
+        if(!idlest) {
+            return;
+        }
+
+        releaseCollection(*idlest);
+    }
+}
+
+std::optional<Collection> Database::getCollectionCopy(std::string collectionName) const {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
         Logger::logWarning(collectionName + "  does not exist in database: " + _name + ".");
         return std::nullopt;
     }
 
-    return it->second;
+    return *collection;
+}
+
+Database::~Database() {
+    try {
+        checkpoint();
+    }
+    catch(const std::exception& e) {
+        Logger::logError("Failed to take checkpoint of database: " + _name + ": " + e.what() + ".");
+    }
+}
+
+void Database::checkpoint() {
+    if(!_wal && !_options.snapshots) {
+        return;
+    }
+
+    uint64_t lsn = _wal ? _wal->getLsn() : 0;
+
+    // Files written here must reach disk before log records are dropped, only they are synced
+    bool durable = _wal && _options.wal.sync != SyncPolicy::Never;
+
+    // Without log, mutations were already saved in document files
+    for(const auto& [collectionName, ids] : _dirty) {
+        auto it = _collections.find(collectionName);
+        if(it == _collections.end()) {
+            continue;
+        }
+
+        auto& collection = it->second;
+        std::string path = _path + '/' + collectionName;
+
+        std::vector<const Document*> saved;
+        for(auto id : ids) {
+            if(auto handle = collection.getHandle(id)) {
+                saved.push_back(collection.getDocument(*handle));
+            }
+            else {
+                _storage.removeDocument(path, id);
+            }
+        }
+
+        _storage.saveDocuments(path, saved);
+        if(durable) {
+            _storage.syncDocuments(path, ids);
+        }
+    }
+
+    // Snapshot may only capture state persisted in document files or log, so collections handed out for direct
+    // mutation are never snapshotted
+    for(const auto& [collectionName, collection] : _collections) {
+        bool dirty = _dirty.find(collectionName) != _dirty.end();
+        if(!_options.snapshots || _exposed.find(collectionName) != _exposed.end()) {
+            if(dirty) {
+                invalidateSnapshot(collectionName);
+            }
+        }
+        else if(dirty || _snapshotLsns.find(collectionName) == _snapshotLsns.end()) {
+            std::filesystem::path directory = _path + '/' + collectionName;
+            Snapshot::write(directory, collection, lsn);
+            _snapshotLsns[collectionName] = lsn;
+
+            if(durable) {
+                syncPath(directory / Snapshot::fileName);
+                syncPath(directory);
+            }
+        }
+    }
+
+    _dirty.clear();
+    if(_wal) {
+        _wal->reset();
+    }
+}
+
+std::optional<uint64_t> Database::loadCollection(Collection& collection, const std::filesystem::path& collectionPath) const {
+    auto snapshot = Snapshot::read(collectionPath);
+    if(!snapshot) {
+        collection.insertMany(_storage.loadDocuments(collectionPath, _options.loading));
+        return std::nullopt;
+    }
+
+    collection.insertMany(std::move(snapshot->documents));
+    for(const auto& [field, type] : snapshot->indexes) {
+        collection.createIndex(field, type);
+    }
+
+    return snapshot->lsn;
+}
+
+void Database::invalidateSnapshot(const std::string& collectionName) {
+    if(_snapshotLsns.erase(collectionName) > 0) {
+        Snapshot::remove(_path + '/' + collectionName);
+    }
+}
+
+void Database::recover() {
+    auto walPath = std::filesystem::path(_path) / "wal.log";
+    if(!_options.wal.enabled && !std::filesystem::exists(walPath)) {
+        return;
+    }
+
+    // New log continues after LSNs covered by snapshots, so its records are never mistaken for covered ones
+    uint64_t initialLsn{0};
+    for(const auto& [collectionName, lsn] : _snapshotLsns) {
+        initialLsn = std::max(initialLsn, lsn);
+    }
+    for(const auto& collectionName : _unloaded) {
+        initialLsn = std::max(initialLsn, Snapshot::readLsn(_path + '/' + collectionName).value_or(0));
+    }
+
+    _wal = std::make_unique<WriteAheadLog>(walPath, _options.wal.sync, _options.wal.syncInterval, initialLsn);
+
+    auto records = _wal->read();
+    size_t replayed{0};
+    for(auto& record : records) {
+        auto* collection = findCollection(record.collection);
+        if(!collection) {
+            Logger::logWarning("Skipped write-ahead log record of non existing collection: " + record.collection + ".");
+            continue;
+        }
+
+        // Only tail of log written after snapshot is replayed
+        auto snapshotLsn = _snapshotLsns.find(record.collection);
+        if(snapshotLsn != _snapshotLsns.end() && record.lsn <= snapshotLsn->second) {
+            continue;
+        }
+
+        if(record.type == WalRecord::Type::Put) {
+            if(collection->getHandle(record.id)) {
+                collection->update(*record.doc);
+            }
+            else {
+                collection->insert(std::move(*record.doc));
+            }
+        }
+        else if(collection->getHandle(record.id)) {
+            Document removed;
+            removed.set("id", record.id);
+            collection->remove(removed);
+        }
+
+        _dirty[record.collection].insert(record.id);
+        ++replayed;
+    }
+
+    if(replayed > 0) {
+        Logger::logInfo("Replayed " + std::to_string(replayed) + " write-ahead log record(s) of database: " + _name + ".");
+    }
+
+    checkpoint();
+
+    // Log left by database opened with it enabled is no longer needed once replayed
+    if(!_options.wal.enabled) {
+        _wal.reset();
+        std::filesystem::remove(walPath);
+    }
+}
+
+void Database::persist(const std::string& collectionName, const std::vector<const Document*>& docs) {
+    if(docs.empty()) {
+        return;
+    }
+
+    if(!_wal) {
+        invalidateSnapshot(collectionName);
+
+        std::string path = _path + '/' + collectionName;
+        if(docs.size() == 1) {
+            _storage.saveDocument(path, *docs.front());
+        }
+        else {
+            _storage.saveDocuments(path, docs);
+        }
+        return;
+    }
+
+    _wal->logPuts(collectionName, docs);
+
+    auto& dirty = _dirty[collectionName];
+    for(const auto* doc : docs) {
+        dirty.insert(*doc->get<size_t>("id"));
+    }
+
+    if(_wal->size() >= _options.wal.checkpointBytes) {
+        checkpoint();
+    }
+}
+
+void Database::persistRemoval(const std::string& collectionName, const std::vector<size_t>& ids) {
+    if(ids.empty()) {
+        return;
+    }
+
+    if(!_wal) {
+        invalidateSnapshot(collectionName);
+
+        std::string path = _path + '/' + collectionName;
+        for(auto id : ids) {
+            _storage.removeDocument(path, id);
+        }
+        return;
+    }
+
+    _wal->logRemoves(collectionName, ids);
+    _dirty[collectionName].insert(ids.begin(), ids.end());
+
+    if(_wal->size() >= _options.wal.checkpointBytes) {
+        checkpoint();
+    }
+}
+
+void Database::convertStorage(StorageFormat format) {
+    for(const auto& [collectionName, collection] : _collections) {
+        _storage.convertCollection(_path + '/' + collectionName, format);
+    }
+    for(const auto& collectionName : _unloaded) {
+        _storage.convertCollection(_path + '/' + collectionName, format);
+    }
+
+    _options.storageFormat = format;
+    _storage.setFormat(format);
 }
 
 void Database::addCollection(std::string collectionName) {
-    auto it = _collections.find(collectionName);
-    if(it != _collections.end()) {
+    if(_collections.find(collectionName) != _collections.end() || _unloaded.find(collectionName) != _unloaded.end()) {
         Logger::logWarning(collectionName + " collection already exists in database: " + _name + ".");
         return;
     }
@@ -65,14 +402,16 @@ void Database::addCollection(std::string collectionName) {
 
     std::string path = _path + '/' + collectionName;
     ensureDirectoryExists(path, resetCollectionDirectory);
+    _snapshotLsns.erase(collectionName);
+    _exposed.erase(collectionName);
 
-    _collections.emplace(collectionName, Collection(collectionName));
+    _collections.emplace(collectionName, Collection(collectionName, _options.idStrategy));
 }
 
 void Database::insertCollection(Collection collection) {
     std::string collectionName = collection.getName();
 
-    if(_collections.find(collectionName) != _collections.end()) {
+    if(_collections.find(collectionName) != _collections.end() || _unloaded.find(collectionName) != _unloaded.end()) {
         Logger::logWarning(collectionName + " already exists in database: " + _name + ".");
         return;
     }
@@ -81,32 +420,58 @@ void Database::insertCollection(Collection collection) {
     
     bool resetCollectionDirectory = true;
     ensureDirectoryExists(path, resetCollectionDirectory);
+    _snapshotLsns.erase(collectionName);
+    _exposed.erase(collectionName);
 
-    for(auto doc : collection.getAll()) {
-        _storage.saveDocument(path, doc);
+    std::vector<const Document*> docs;
+    docs.reserve(collection.size());
+    for(const auto& doc : collection.getAllView()) {
+        docs.push_back(&doc);
     }
+    _storage.saveDocuments(path, docs);
 
     _collections.insert({collectionName, std::move(collection)});
     Logger::logInfo("Inserted new collection: " + collectionName + " to database: " + _name + ".");
 }
 
 void Database::insert(std::string collectionName, Document doc) {
-    auto it = _collections.find(collectionName);
-    if(it == _collections.end()) {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
         Logger::logWarning(collectionName + " does not exist in database: " + _name + ".");
         return;
     }   
 
-    auto& collection = it->second;
-    collection.insert(doc);
+    auto id = collection->insert(std::move(doc));
+    if(!id) {
+        return;
+    }
+
+    persist(collectionName, {collection->getDocument(*collection->getHandle(*id))});
+}
 
-    std::string path = _path + '/' + collectionName;
-    _storage.saveDocument(path, doc);
+std::vector<size_t> Database::insertMany(std::string collectionName, std::vector<Document> docs) {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
+        Logger::logWarning(collectionName + " does not exist in database: " + _name + ".");
+        return std::vector<size_t>();
+    }
+
+    auto ids = collection->insertMany(std::move(docs));
+
+    std::vector<const Document*> inserted;
+    inserted.reserve(ids.size());
+    for(auto id : ids) {
+        inserted.push_back(collection->getDocument(*collection->getHandle(id)));
+    }
+
+    persist(collectionName, inserted);
+
+    return ids;
 }
 
 void Database::remove(std::string collectionName, Document& doc) {
-    auto it = _collections.find(collectionName);
-    if(it == _collections.end()) {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
         Logger::logWarning(collectionName + " does not exist in database: " + _name + ".");
         return;
     }
@@ -116,28 +481,65 @@ void Database::remove(std::string collectionName, Document& doc) {
         return;
     }
 
-    auto& collection = it->second;
-    collection.remove(doc);
+    collection->remove(doc);
 
-    std::string colllectionPath = _path + "/" + collectionName;
-    _storage.removeDocument(colllectionPath, *idOpt);
+    persistRemoval(collectionName, {*idOpt});
+}
+
+std::vector<Document> Database::findEqual(std::string collectionName, const std::string& field, const Document::Value& value) const {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
+        Logger::logWarning(collectionName + " does not exist in database: " + _name + ".");
+        return std::vector<Document>();
+    }
+
+    return collection->findEqual(field, value);
+}
+
+std::vector<Document> Database::findRange(std::string collectionName, const std::string& field, const std::optional<Bound>& lower, const std::optional<Bound>& upper) const {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
+        Logger::logWarning(collectionName + " does not exist in database: " + _name + ".");
+        return std::vector<Document>();
+    }
+
+    return collection->findRange(field, lower, upper);
+}
+
+void Database::createIndex(std::string collectionName, const std::string& field, IndexType type) {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
+        Logger::logWarning(collectionName + " does not exist in database: " + _name + ".");
+        return;
+    }
+
+    collection->createIndex(field, type);
 }
 
 std::vector<Document> Database::getAll(std::string collectionName) const {
-    auto it = _collections.find(collectionName);
-    if(it == _collections.end()) {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
         Logger::logWarning(collectionName + " does not exist in database: " + _name + ".");
         return std::vector<Document>();
     }
 
-    auto& collection = it->second;
+    return collection->getAll();
+}
+
+Cursor<MatchAll> Database::getAllView(std::string collectionName) const {
+    auto* collection = findCollection(collectionName);
+    if(!collection) {
+        Logger::logWarning(collectionName + " does not exist in database: " + _name + ".");
+        return Cursor<MatchAll>(nullptr, MatchAll{});
+    }
 
-    return collection.getAll();
+    return collection->getAllView();
 }
 
 void Database::ensureDirectoryExists(const std::filesystem::path& path, bool reset) {
     try {
         if (reset && std::filesystem::exists(path)) {
+            _storage.closeCollection(path.string());
             std::filesystem::remove_all(path);
         }
 
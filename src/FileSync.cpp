@@ -0,0 +1,23 @@
+#include "FileSync.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+void syncPath(const std::filesystem::path& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) {
+        throw std::runtime_error("Cannot open: " + path.string() + " to sync it: " + std::strerror(errno));
+    }
+
+    if(::fsync(fd) != 0) {
+        auto error = errno;
+        ::close(fd);
+        throw std::runtime_error("Cannot sync: " + path.string() + ": " + std::strerror(error));
+    }
+
+    ::close(fd);
+}
@@ -0,0 +1,38 @@
+#include "HashIndex.hpp"
+
+void HashIndex::insert(const Document& doc, SlotHandle handle) {
+    const auto& data = doc.getDataView();
+    auto it = data.find(_field);
+    if(it == data.end() || !ValueComparator::isScalar(it->second)) {
+        return;
+    }
+
+    _entries[it->second].insert(handle);
+}
+
+void HashIndex::remove(const Document& doc, SlotHandle handle) {
+    const auto& data = doc.getDataView();
+    auto it = data.find(_field);
+    if(it == data.end() || !ValueComparator::isScalar(it->second)) {
+        return;
+    }
+
+    auto entry = _entries.find(it->second);
+    if(entry == _entries.end()) {
+        return;
+    }
+
+    entry->second.erase(handle);
+    if(entry->second.empty()) {
+        _entries.erase(entry);
+    }
+}
+
+const HashIndex::Postings* HashIndex::find(const Document::Value& value) const {
+    auto it = _entries.find(value);
+    if(it == _entries.end()) {
+        return nullptr;
+    }
+
+    return &it->second;
+}
@@ -0,0 +1,49 @@
+#include "IdGenerator.hpp"
+
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+size_t IdGenerator::next(const std::unordered_set<size_t>& taken) {
+    switch(_strategy) {
+        case IdStrategy::Monotonic:
+            break;
+        case IdStrategy::TimeOrdered: {
+            auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            auto millis = static_cast<uint64_t>(now) - epochMillis;
+
+            // Within one millisecond, or after clock moved back, sequence continues from last id
+            size_t candidate = static_cast<size_t>(millis << sequenceBits);
+            if(candidate > _last) {
+                _last = candidate;
+                return _last;
+            }
+            break;
+        }
+        default: {
+            auto maxIterations{100};
+            for(auto i{0}; i < maxIterations; ++i) {
+                auto id = _rng();
+                if(taken.find(id) == taken.end()) {
+                    return id;
+                }
+            }
+
+            throw std::runtime_error("Failed to generate unique document ID after " + std::to_string(maxIterations) + " attempts.");
+        }
+    }
+
+    if(_last == std::numeric_limits<size_t>::max()) {
+        throw std::runtime_error("Ran out of document ids.");
+    }
+
+    return ++_last;
+}
+
+void IdGenerator::observe(size_t id) {
+    if(_strategy != IdStrategy::Random && id > _last) {
+        _last = id;
+    }
+}
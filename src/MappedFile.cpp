@@ -0,0 +1,66 @@
+#include "MappedFile.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) {
+        throw std::runtime_error("Cannot open file: " + path.string() + ": " + std::strerror(errno));
+    }
+
+    struct stat status{};
+    if(::fstat(fd, &status) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat file: " + path.string() + ": " + std::strerror(errno));
+    }
+
+    auto size = static_cast<size_t>(status.st_size);
+    if(size >= mapThreshold) {
+        void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(mapping != MAP_FAILED) {
+            ::madvise(mapping, size, MADV_SEQUENTIAL);
+            ::close(fd);
+
+            _mapping = mapping;
+            _data = std::string_view(static_cast<const char*>(mapping), size);
+            return;
+        }
+    }
+
+    // Small files, and files which cannot be mapped, are read with single read per call
+    _buffer.resize(size);
+    size_t done{0};
+    while(done < size) {
+        auto read = ::read(fd, _buffer.data() + done, size - done);
+        if(read < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+
+            auto error = errno;
+            ::close(fd);
+            throw std::runtime_error("Cannot read file: " + path.string() + ": " + std::strerror(error));
+        }
+        if(read == 0) {
+            break;
+        }
+        done += static_cast<size_t>(read);
+    }
+    ::close(fd);
+
+    // File may shrink between fstat and read
+    _buffer.resize(done);
+    _data = _buffer;
+}
+
+MappedFile::~MappedFile() {
+    if(_mapping) {
+        ::munmap(_mapping, _data.size());
+    }
+}
@@ -0,0 +1,137 @@
+#include "OrderedIndex.hpp"
+
+void OrderedIndex::insert(const Document& doc, SlotHandle handle) {
+    const auto& data = doc.getDataView();
+    auto it = data.find(_field);
+    if(it == data.end() || !ValueComparator::isOrderable(it->second)) {
+        return;
+    }
+
+    _entries[it->second].insert(handle);
+}
+
+void OrderedIndex::remove(const Document& doc, SlotHandle handle) {
+    const auto& data = doc.getDataView();
+    auto it = data.find(_field);
+    if(it == data.end() || !ValueComparator::isOrderable(it->second)) {
+        return;
+    }
+
+    auto entry = _entries.find(it->second);
+    if(entry == _entries.end()) {
+        return;
+    }
+
+    entry->second.erase(handle);
+    if(entry->second.empty()) {
+        _entries.erase(entry);
+    }
+}
+
+std::vector<SlotHandle> OrderedIndex::range(const std::optional<Bound>& lower, const std::optional<Bound>& upper) const {
+    std::vector<SlotHandle> handles;
+
+    auto [first, last] = locate(lower, upper);
+    collect(first, last, handles);
+
+    return handles;
+}
+
+size_t OrderedIndex::count(const std::optional<Bound>& lower, const std::optional<Bound>& upper, size_t limit) const {
+    size_t result{0};
+
+    auto [first, last] = locate(lower, upper);
+    for(auto it = first; it != last && result <= limit; ++it) {
+        result += it->second.size();
+    }
+
+    return result;
+}
+
+std::pair<OrderedIndex::Entries::const_iterator, OrderedIndex::Entries::const_iterator> OrderedIndex::locate(const std::optional<Bound>& lower, const std::optional<Bound>& upper) const {
+    auto empty = std::make_pair(_entries.end(), _entries.end());
+
+    if((lower && !ValueComparator::isOrderable(lower->value)) || (upper && !ValueComparator::isOrderable(upper->value))) {
+        return empty;
+    }
+
+    if(!lower && !upper) {
+        return std::make_pair(_entries.begin(), _entries.end());
+    }
+
+    // Range is limited to the kind of its bounds, so "age >= 10" never reaches strings
+    bool numeric = ValueComparator::isNumeric(lower ? lower->value : upper->value);
+    if(lower && upper && ValueComparator::isNumeric(upper->value) != numeric) {
+        return empty;
+    }
+
+    Entries::const_iterator first;
+    if(lower) {
+        first = lower->inclusive ? _entries.lower_bound(lower->value) : _entries.upper_bound(lower->value);
+    }
+    else {
+        first = numeric ? _entries.begin() : _entries.lower_bound(std::string());
+    }
+
+    Entries::const_iterator last;
+    if(upper) {
+        last = upper->inclusive ? _entries.upper_bound(upper->value) : _entries.lower_bound(upper->value);
+    }
+    else {
+        last = numeric ? _entries.lower_bound(std::string()) : _entries.end();
+    }
+
+    if(first == _entries.end() || (last != _entries.end() && ValueComparator::order(first->first, last->first) > 0)) {
+        return empty;
+    }
+
+    return std::make_pair(first, last);
+}
+
+std::vector<SlotHandle> OrderedIndex::prefix(const std::string& prefix) const {
+    std::vector<SlotHandle> handles;
+
+    for(auto it = _entries.lower_bound(prefix); it != _entries.end(); ++it) {
+        const auto& key = std::get<std::string>(it->first);
+        if(key.compare(0, prefix.size(), prefix) != 0) {
+            break;
+        }
+
+        handles.insert(handles.end(), it->second.begin(), it->second.end());
+    }
+
+    return handles;
+}
+
+bool OrderedIndex::inRange(const Document::Value& value, const std::optional<Bound>& lower, const std::optional<Bound>& upper) {
+    if(!ValueComparator::isOrderable(value)) {
+        return false;
+    }
+
+    for(const auto* bound : {&lower, &upper}) {
+        if(!*bound) {
+            continue;
+        }
+
+        const auto& boundValue = (*bound)->value;
+        if(!ValueComparator::isOrderable(boundValue) || ValueComparator::isNumeric(boundValue) != ValueComparator::isNumeric(value)) {
+            return false;
+        }
+
+        int result = ValueComparator::order(value, boundValue);
+        if(bound == &lower ? result < 0 : result > 0) {
+            return false;
+        }
+        if(result == 0 && !(*bound)->inclusive) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void OrderedIndex::collect(Entries::const_iterator first, Entries::const_iterator last, std::vector<SlotHandle>& handles) {
+    for(auto it = first; it != last; ++it) {
+        handles.insert(handles.end(), it->second.begin(), it->second.end());
+    }
+}
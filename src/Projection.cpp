@@ -0,0 +1,132 @@
+#include "Projection.hpp"
+
+Projection::Projection(bool include, const std::vector<std::string>& paths) : _include(include) {
+    for(const auto& path : paths) {
+        Node* node = &_root;
+
+        size_t begin{0};
+        while(begin <= path.size()) {
+            size_t end = path.find('.', begin);
+            if(end == std::string::npos) {
+                end = path.size();
+            }
+
+            node = &node->children[path.substr(begin, end - begin)];
+            begin = end + 1;
+        }
+
+        node->terminal = true;
+    }
+}
+
+Document Projection::apply(const Document& doc) const {
+    if(!_include) {
+        return excludeFields(doc, _root);
+    }
+
+    auto projected = includeFields(doc, _root);
+    if(auto id = doc.get<size_t>("id")) {
+        projected.set("id", *id);
+    }
+
+    return projected;
+}
+
+Document Projection::includeFields(const Document& doc, const Node& node) {
+    Document projected;
+    const auto& data = doc.getDataView();
+
+    for(const auto& [segment, child] : node.children) {
+        auto it = data.find(segment);
+        if(it == data.end()) {
+            continue;
+        }
+
+        if(child.terminal) {
+            projected.getData().emplace(segment, it->second);
+        }
+        else if(auto value = includeValue(it->second, child)) {
+            projected.getData().emplace(segment, std::move(*value));
+        }
+    }
+
+    return projected;
+}
+
+std::optional<Document::Value> Projection::includeValue(const Document::Value& value, const Node& node) {
+    if(const auto* documentType = std::get_if<Document>(&value)) {
+        return includeFields(*documentType, node);
+    }
+
+    if(const auto* vectorType = std::get_if<Document::Vector>(&value)) {
+        Document::Vector projected;
+        projected.reserve(vectorType->size());
+        for(const auto& element : *vectorType) {
+            projected.push_back(includeFields(element, node));
+        }
+        return projected;
+    }
+
+    if(const auto* mapType = std::get_if<Document::Map>(&value)) {
+        Document::Map projected;
+        for(const auto& [segment, child] : node.children) {
+            auto it = mapType->find(segment);
+            if(it == mapType->end()) {
+                continue;
+            }
+
+            projected.emplace(segment, child.terminal ? it->second : includeFields(it->second, child));
+        }
+        return projected;
+    }
+
+    // Path continues below scalar, so it does not exist
+    return std::nullopt;
+}
+
+Document Projection::excludeFields(const Document& doc, const Node& node) {
+    Document projected;
+
+    for(const auto& [key, value] : doc.getDataView()) {
+        auto child = node.children.find(key);
+        if(child == node.children.end()) {
+            projected.getData().emplace(key, value);
+        }
+        else if(!child->second.terminal) {
+            projected.getData().emplace(key, excludeValue(value, child->second));
+        }
+    }
+
+    return projected;
+}
+
+Document::Value Projection::excludeValue(const Document::Value& value, const Node& node) {
+    if(const auto* documentType = std::get_if<Document>(&value)) {
+        return excludeFields(*documentType, node);
+    }
+
+    if(const auto* vectorType = std::get_if<Document::Vector>(&value)) {
+        Document::Vector projected;
+        projected.reserve(vectorType->size());
+        for(const auto& element : *vectorType) {
+            projected.push_back(excludeFields(element, node));
+        }
+        return projected;
+    }
+
+    if(const auto* mapType = std::get_if<Document::Map>(&value)) {
+        Document::Map projected;
+        for(const auto& [key, doc] : *mapType) {
+            auto child = node.children.find(key);
+            if(child == node.children.end()) {
+                projected.emplace(key, doc);
+            }
+            else if(!child->second.terminal) {
+                projected.emplace(key, excludeFields(doc, child->second));
+            }
+        }
+        return projected;
+    }
+
+    return value;
+}
@@ -0,0 +1,40 @@
+#include "Query.hpp"
+
+bool Predicate::matches(const Document& doc) const {
+    const auto& data = doc.getDataView();
+    auto it = data.find(field);
+    return test(op, it != data.end() ? &it->second : nullptr, value);
+}
+
+bool Predicate::test(Operator op, const Document::Value* fieldValue, const Document::Value& value) {
+    if(!fieldValue) {
+        return op == Operator::NotEqual;
+    }
+
+    switch(op) {
+        case Operator::Equal:
+            return ValueComparator::equal(*fieldValue, value);
+        case Operator::NotEqual:
+            return !ValueComparator::equal(*fieldValue, value);
+        default:
+            break;
+    }
+
+    auto result = ValueComparator::compare(*fieldValue, value);
+    if(!result) {
+        return false;
+    }
+
+    switch(op) {
+        case Operator::Less:
+            return *result < 0;
+        case Operator::LessEqual:
+            return *result <= 0;
+        case Operator::Greater:
+            return *result > 0;
+        case Operator::GreaterEqual:
+            return *result >= 0;
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,98 @@
+#include "QueryPlan.hpp"
+
+#include <sstream>
+
+namespace {
+
+/// @brief Describe scalar value
+std::string describeValue(const Document::Value& value) {
+    std::ostringstream stream;
+
+    if(const auto* intType = std::get_if<int>(&value)) {
+        stream << *intType;
+    }
+    else if(const auto* size_tType = std::get_if<size_t>(&value)) {
+        stream << *size_tType;
+    }
+    else if(const auto* doubleType = std::get_if<double>(&value)) {
+        stream << *doubleType;
+    }
+    else if(const auto* stringType = std::get_if<std::string>(&value)) {
+        stream << '"' << *stringType << '"';
+    }
+    else if(const auto* boolType = std::get_if<bool>(&value)) {
+        stream << (*boolType ? "true" : "false");
+    }
+    else {
+        stream << "(nested)";
+    }
+
+    return stream.str();
+}
+
+/// @brief Describe comparison operator
+const char* describeOperator(Operator op) {
+    switch(op) {
+        case Operator::Equal: return "==";
+        case Operator::NotEqual: return "!=";
+        case Operator::Less: return "<";
+        case Operator::LessEqual: return "<=";
+        case Operator::Greater: return ">";
+        case Operator::GreaterEqual: return ">=";
+    }
+    return "?";
+}
+
+}
+
+bool QueryPlan::matchesResidual(const Document& doc) const {
+    for(const auto& predicate : residual) {
+        if(!predicate.matches(doc)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::string QueryPlan::toString() const {
+    std::ostringstream stream;
+
+    if(isFullScan()) {
+        stream << "FULL SCAN";
+    }
+
+    for(size_t i{0}; i < accessPaths.size(); ++i) {
+        const auto& path = accessPaths[i];
+        stream << (i == 0 ? "INDEX SCAN " : " INTERSECT ");
+
+        if(path.type == IndexType::Hash) {
+            stream << "hash(" << path.field << " == " << describeValue(*path.value) << ")";
+        }
+        else {
+            stream << "ordered(" << path.field << " in "
+                << (path.lower && path.lower->inclusive ? '[' : '(')
+                << (path.lower ? describeValue(path.lower->value) : "-inf") << ", "
+                << (path.upper ? describeValue(path.upper->value) : "+inf")
+                << (path.upper && path.upper->inclusive ? ']' : ')') << ")";
+        }
+
+        stream << " estimated: " << path.estimated;
+    }
+
+    if(!residual.empty()) {
+        stream << " FILTER ";
+        for(size_t i{0}; i < residual.size(); ++i) {
+            const auto& predicate = residual[i];
+            stream << (i == 0 ? "" : " && ") << predicate.field << ' ' << describeOperator(predicate.op) << ' ' << describeValue(predicate.value);
+        }
+    }
+
+    if(!complete) {
+        stream << " FILTER query";
+    }
+
+    stream << "; estimated scanned: " << estimatedScanned << ", scanned: " << scanned << ", returned: " << returned;
+
+    return stream.str();
+}
@@ -0,0 +1,560 @@
+#include "SegmentStore.hpp"
+
+#include "BinaryCodec.hpp"
+#include "FileSync.hpp"
+#include "Logger.hpp"
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+/// @brief Size of chunks in which compaction reads and writes segments
+constexpr size_t compactionChunkSize{1 << 16};
+
+/// @brief Limits rate of I/O by sleeping once more bytes were consumed than allowed so far
+class Throttle {
+public:
+    /// @brief Construct a throttle
+    /// @param bytesPerSecond Limit of bytes per second, 0 for no limit
+    explicit Throttle(uint64_t bytesPerSecond) : _bytesPerSecond(bytesPerSecond), _start(std::chrono::steady_clock::now()) {}
+
+    /// @brief Account bytes, sleeping until they are allowed
+    /// @param bytes Number of read or written bytes
+    void consume(uint64_t bytes) {
+        if(_bytesPerSecond == 0) {
+            return;
+        }
+
+        _bytes += bytes;
+        std::chrono::duration<double> due(static_cast<double>(_bytes) / static_cast<double>(_bytesPerSecond));
+        std::this_thread::sleep_until(_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(due));
+    }
+
+private:
+    /// @brief Limit of bytes per second
+    uint64_t _bytesPerSecond;
+
+    /// @brief Number of consumed bytes
+    uint64_t _bytes{0};
+
+    /// @brief Time of construction
+    std::chrono::steady_clock::time_point _start;
+};
+
+}
+
+SegmentStore::SegmentStore(std::filesystem::path directory, uint64_t maxSegmentSize)
+    : _directory(std::move(directory)), _maxSegmentSize(maxSegmentSize) {
+    if(!std::filesystem::exists(_directory)) {
+        return;
+    }
+
+    for(const auto& entry : std::filesystem::directory_iterator(_directory)) {
+        if(!entry.is_regular_file()) {
+            continue;
+        }
+
+        if(isSegment(entry.path())) {
+            _segments.push_back(static_cast<uint32_t>(std::stoul(entry.path().stem().string())));
+        }
+        // Compaction interrupted before its result was swapped in, original segment is intact
+        else if(entry.path().extension() == ".compact") {
+            std::filesystem::remove(entry.path());
+        }
+    }
+
+    std::sort(_segments.begin(), _segments.end());
+}
+
+std::vector<Document> SegmentStore::load() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::vector<Document> documents;
+    scan(&documents);
+    return documents;
+}
+
+void SegmentStore::put(const Document& doc) {
+    put(std::vector<const Document*>{&doc});
+}
+
+void SegmentStore::put(const std::vector<const Document*>& docs) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ensureLoaded();
+
+    std::string records;
+    std::string payload;
+    std::vector<std::pair<size_t, Location>> puts;
+    puts.reserve(docs.size());
+
+    for(const auto* doc : docs) {
+        auto idOpt = doc->get<size_t>("id");
+        if(!idOpt) {
+            throw std::runtime_error("Trying to save document without id.");
+        }
+
+        payload.clear();
+        BinaryCodec::encode(*doc, payload);
+
+        Location location{0, records.size() + headerSize, static_cast<uint32_t>(payload.size())};
+        encodeRecord(RecordType::Put, *idOpt, payload, records);
+        puts.emplace_back(*idOpt, location);
+    }
+
+    append(records, puts);
+}
+
+bool SegmentStore::remove(size_t id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ensureLoaded();
+
+    if(_locations.find(id) == _locations.end()) {
+        return false;
+    }
+
+    std::string record;
+    encodeRecord(RecordType::Tombstone, id, {}, record);
+    append(record, {});
+    _stats[_segments.back()].tombstoneBytes += record.size();
+    relocate(id, std::nullopt);
+
+    return true;
+}
+
+bool SegmentStore::contains(size_t id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ensureLoaded();
+
+    return _locations.find(id) != _locations.end();
+}
+
+std::optional<Document> SegmentStore::get(size_t id) {
+    // Lock is held while reading, so compaction cannot swap segment between lookup and read
+    std::lock_guard<std::mutex> lock(_mutex);
+    ensureLoaded();
+
+    auto it = _locations.find(id);
+    if(it == _locations.end()) {
+        return std::nullopt;
+    }
+
+    const auto& location = it->second;
+    std::ifstream file(segmentPath(location.segment), std::ios::binary);
+    file.seekg(static_cast<std::streamoff>(location.offset));
+
+    std::string payload(location.size, '\0');
+    if(!file.read(payload.data(), static_cast<std::streamsize>(payload.size()))) {
+        throw std::runtime_error("Cannot read document of id: " + std::to_string(id) + " from segment.");
+    }
+
+    return BinaryCodec::decode(payload);
+}
+
+size_t SegmentStore::size() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ensureLoaded();
+
+    return _locations.size();
+}
+
+void SegmentStore::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _active.close();
+
+    for(auto segment : _segments) {
+        std::filesystem::remove(segmentPath(segment));
+    }
+
+    _segments.clear();
+    _locations.clear();
+    _stats.clear();
+    _activeSize = 0;
+    _loaded = true;
+}
+
+void SegmentStore::sync() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Segment rewritten by compaction meanwhile was already replaced atomically, missing one was deleted
+    for(auto segment : _unsynced) {
+        auto path = segmentPath(segment);
+        if(std::filesystem::exists(path)) {
+            syncPath(path);
+        }
+    }
+
+    if(!_unsynced.empty()) {
+        syncPath(_directory);
+        _unsynced.clear();
+    }
+}
+
+void SegmentStore::close() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _active.close();
+    _closed = true;
+}
+
+std::vector<SegmentStats> SegmentStore::stats() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ensureLoaded();
+
+    std::vector<SegmentStats> result;
+    result.reserve(_segments.size());
+    for(auto segment : _segments) {
+        result.push_back(_stats[segment]);
+    }
+
+    return result;
+}
+
+size_t SegmentStore::compact(double deadRatio, uint64_t bytesPerSecond) {
+    std::vector<uint32_t> candidates;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(_closed) {
+            return 0;
+        }
+
+        ensureLoaded();
+
+        // Active segment is still appended to, so only sealed ones are rewritten. Tombstones count as dead, but only
+        // oldest segment drops them, so other segments are rewritten only if they have superseded records.
+        for(size_t i{0}; i + 1 < _segments.size(); ++i) {
+            const auto& stats = _stats[_segments[i]];
+            bool reclaimable = stats.totalBytes > stats.liveBytes + stats.tombstoneBytes || (i == 0 && stats.tombstoneBytes > 0);
+            if(reclaimable && stats.deadRatio() >= deadRatio) {
+                candidates.push_back(_segments[i]);
+            }
+        }
+    }
+
+    size_t compacted{0};
+    for(auto segment : candidates) {
+        if(compactSegment(segment, bytesPerSecond)) {
+            ++compacted;
+        }
+    }
+
+    return compacted;
+}
+
+bool SegmentStore::compactSegment(uint32_t segment, uint64_t bytesPerSecond) {
+    std::unordered_map<uint64_t, size_t> live;
+    bool keepTombstones;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(_closed || _segments.empty() || _segments.back() == segment
+            || std::find(_segments.begin(), _segments.end(), segment) == _segments.end()) {
+            return false;
+        }
+
+        // Tombstone only matters while older segment may still hold removed document
+        keepTombstones = segment != _segments.front();
+        for(const auto& [id, location] : _locations) {
+            if(location.segment == segment) {
+                live.emplace(location.offset, id);
+            }
+        }
+    }
+
+    // Sealed segment is never written, so it is read and rewritten without holding the lock
+    Throttle throttle(bytesPerSecond);
+    auto path = segmentPath(segment);
+
+    std::ifstream input(path, std::ios::binary);
+    std::string data(static_cast<size_t>(std::filesystem::file_size(path)), '\0');
+    for(size_t pos{0}; pos < data.size(); pos += compactionChunkSize) {
+        auto chunk = std::min(compactionChunkSize, data.size() - pos);
+        input.read(data.data() + pos, static_cast<std::streamsize>(chunk));
+        throttle.consume(chunk);
+    }
+
+    if(!input) {
+        throw std::runtime_error("Cannot read segment: " + path.string());
+    }
+
+    struct Moved {
+        size_t id;
+        uint64_t from;
+        uint64_t to;
+        uint32_t size;
+    };
+
+    std::string compacted;
+    std::vector<Moved> moved;
+    uint64_t tombstoneBytes{0};
+
+    size_t pos{0};
+    while(data.size() - pos >= headerSize) {
+        auto type = static_cast<RecordType>(data[pos]);
+        auto id = static_cast<size_t>(BinaryCodec::Reader{data, pos + 1}.fixed(8));
+        auto size = static_cast<uint32_t>(BinaryCodec::Reader{data, pos + 9}.fixed(4));
+        if(data.size() - pos - headerSize < size) {
+            break;
+        }
+
+        std::string_view record(data.data() + pos, headerSize + size);
+        if(type == RecordType::Put) {
+            auto it = live.find(pos + headerSize);
+            if(it != live.end() && it->second == id) {
+                moved.push_back({id, pos + headerSize, compacted.size() + headerSize, size});
+                compacted.append(record);
+            }
+        }
+        else if(keepTombstones) {
+            tombstoneBytes += record.size();
+            compacted.append(record);
+        }
+
+        pos += record.size();
+    }
+
+    auto temporary = path;
+    temporary += ".compact";
+
+    if(!compacted.empty()) {
+        std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+        for(size_t written{0}; written < compacted.size(); written += compactionChunkSize) {
+            auto chunk = std::min(compactionChunkSize, compacted.size() - written);
+            output.write(compacted.data() + written, static_cast<std::streamsize>(chunk));
+            throttle.consume(chunk);
+        }
+
+        output.close();
+        if(!output) {
+            std::filesystem::remove(temporary);
+            throw std::runtime_error("Cannot write compacted segment: " + temporary.string());
+        }
+
+        // Rename may reach disk before data, which would replace sealed segment with incomplete one after crash
+        syncPath(temporary);
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = std::find(_segments.begin(), _segments.end(), segment);
+    if(_closed || it == _segments.end()) {
+        std::filesystem::remove(temporary);
+        return false;
+    }
+
+    // Documents updated or removed during rewrite keep their newer location, their copy becomes dead
+    SegmentStats stats{segment, compacted.size(), 0, tombstoneBytes};
+    for(const auto& record : moved) {
+        auto location = _locations.find(record.id);
+        if(location != _locations.end() && location->second.segment == segment && location->second.offset == record.from) {
+            location->second.offset = record.to;
+            stats.liveBytes += headerSize + record.size;
+        }
+    }
+
+    if(compacted.empty()) {
+        std::filesystem::remove(path);
+        _segments.erase(it);
+        _stats.erase(segment);
+    }
+    else {
+        std::filesystem::rename(temporary, path);
+        _stats[segment] = stats;
+    }
+
+    syncPath(_directory);
+
+    Logger::logInfo("Compacted segment: " + path.string() + " from " + std::to_string(data.size()) + " to " + std::to_string(compacted.size()) + " byte(s).");
+
+    return true;
+}
+
+bool SegmentStore::hasSegments(const std::filesystem::path& directory) {
+    if(!std::filesystem::exists(directory)) {
+        return false;
+    }
+
+    for(const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if(entry.is_regular_file() && isSegment(entry.path())) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void SegmentStore::scan(std::vector<Document>* documents) {
+    _locations.clear();
+    _stats.clear();
+    _activeSize = 0;
+
+    // Documents keep position of their first insertion, removed ones leave empty slot
+    std::vector<std::optional<Document>> loaded;
+    std::unordered_map<size_t, size_t> slots;
+
+    for(size_t i{0}; i < _segments.size(); ++i) {
+        auto path = segmentPath(_segments[i]);
+
+        std::optional<MappedFile> file(std::in_place, path);
+        auto data = file->data();
+
+        auto& stats = _stats[_segments[i]];
+        stats.segment = _segments[i];
+
+        size_t pos{0};
+        while(data.size() - pos >= headerSize) {
+            std::string_view header(data.data() + pos, headerSize);
+            auto type = static_cast<RecordType>(header[0]);
+            auto id = static_cast<size_t>(BinaryCodec::Reader{header, 1}.fixed(8));
+            auto size = static_cast<uint32_t>(BinaryCodec::Reader{header, 9}.fixed(4));
+            auto expected = static_cast<uint32_t>(BinaryCodec::Reader{header, 13}.fixed(4));
+
+            if((type != RecordType::Put && type != RecordType::Tombstone) || data.size() - pos - headerSize < size) {
+                break;
+            }
+
+            std::string_view payload(data.data() + pos + headerSize, size);
+            if(checksum(header.substr(0, 13), payload) != expected) {
+                break;
+            }
+
+            if(type == RecordType::Put) {
+                relocate(id, Location{_segments[i], pos + headerSize, size});
+
+                if(documents) {
+                    try {
+                        auto [slot, inserted] = slots.try_emplace(id, loaded.size());
+                        if(inserted) {
+                            loaded.emplace_back();
+                        }
+                        loaded[slot->second] = BinaryCodec::decode(payload);
+                    }
+                    catch(const std::runtime_error& e) {
+                        Logger::logError("Failed to decode document of id: " + std::to_string(id) + " in segment: " + path.string() + ": " + e.what());
+                    }
+                }
+            }
+            else {
+                stats.tombstoneBytes += headerSize;
+                relocate(id, std::nullopt);
+
+                auto slot = slots.find(id);
+                if(slot != slots.end()) {
+                    loaded[slot->second].reset();
+                    slots.erase(slot);
+                }
+            }
+
+            pos += headerSize + size;
+        }
+
+        stats.totalBytes = pos;
+
+        if(pos < data.size()) {
+            bool last = i + 1 == _segments.size();
+            Logger::logWarning("Ignored " + std::to_string(data.size() - pos) + " damaged byte(s) at the end of segment: " + path.string() + ".");
+
+            // Records appended after torn tail would never be reached, so it is cut off once unmapped
+            if(last) {
+                file.reset();
+                std::filesystem::resize_file(path, pos);
+            }
+        }
+
+        if(i + 1 == _segments.size()) {
+            _activeSize = pos;
+        }
+    }
+
+    if(documents) {
+        documents->reserve(slots.size());
+        for(auto& doc : loaded) {
+            if(doc) {
+                documents->push_back(std::move(*doc));
+            }
+        }
+    }
+
+    _loaded = true;
+}
+
+void SegmentStore::append(const std::string& records, const std::vector<std::pair<size_t, Location>>& puts) {
+    if(_segments.empty() || (_activeSize > 0 && _activeSize >= _maxSegmentSize)) {
+        _active.close();
+        _segments.push_back(_segments.empty() ? 1 : _segments.back() + 1);
+        _stats[_segments.back()].segment = _segments.back();
+        _activeSize = 0;
+    }
+
+    if(!_active.is_open()) {
+        _active.open(segmentPath(_segments.back()), std::ios::binary | std::ios::app);
+        if(!_active.is_open()) {
+            throw std::runtime_error("Cannot open segment: " + segmentPath(_segments.back()).string());
+        }
+    }
+
+    _active.write(records.data(), static_cast<std::streamsize>(records.size()));
+    _active.flush();
+    if(!_active) {
+        throw std::runtime_error("Cannot write segment: " + segmentPath(_segments.back()).string());
+    }
+
+    for(auto [id, location] : puts) {
+        location.segment = _segments.back();
+        location.offset += _activeSize;
+        relocate(id, location);
+    }
+
+    _activeSize += records.size();
+    _stats[_segments.back()].totalBytes += records.size();
+
+    if(_unsynced.empty() || _unsynced.back() != _segments.back()) {
+        _unsynced.push_back(_segments.back());
+    }
+}
+
+void SegmentStore::relocate(size_t id, std::optional<Location> location) {
+    auto it = _locations.find(id);
+    if(it != _locations.end()) {
+        _stats[it->second.segment].liveBytes -= headerSize + it->second.size;
+    }
+
+    if(!location) {
+        if(it != _locations.end()) {
+            _locations.erase(it);
+        }
+        return;
+    }
+
+    _stats[location->segment].liveBytes += headerSize + location->size;
+    if(it != _locations.end()) {
+        it->second = *location;
+    }
+    else {
+        _locations.emplace(id, *location);
+    }
+}
+
+void SegmentStore::encodeRecord(RecordType type, size_t id, std::string_view payload, std::string& out) {
+    size_t start = out.size();
+
+    out.push_back(static_cast<char>(type));
+    BinaryCodec::writeFixed(id, 8, out);
+    BinaryCodec::writeFixed(payload.size(), 4, out);
+
+    auto sum = checksum(std::string_view(out.data() + start, 13), payload);
+    BinaryCodec::writeFixed(sum, 4, out);
+    out.append(payload);
+}
+
+uint32_t SegmentStore::checksum(std::string_view header, std::string_view payload) {
+    return BinaryCodec::checksum(payload, BinaryCodec::checksum(header));
+}
+
+std::filesystem::path SegmentStore::segmentPath(uint32_t segment) const {
+    std::ostringstream name;
+    name << std::setw(8) << std::setfill('0') << segment << ".seg";
+    return _directory / name.str();
+}
@@ -0,0 +1,102 @@
+#include "Snapshot.hpp"
+
+#include "BinaryCodec.hpp"
+#include "Logger.hpp"
+#include "MappedFile.hpp"
+
+#include <fstream>
+
+void Snapshot::write(const std::filesystem::path& directory, const Collection& collection, uint64_t lsn) {
+    std::string data(header);
+    BinaryCodec::writeFixed(lsn, 8, data);
+
+    auto indexes = collection.getIndexes();
+    BinaryCodec::writeVarint(indexes.size(), data);
+    for(const auto& [field, type] : indexes) {
+        BinaryCodec::writeString(field, data);
+        data.push_back(static_cast<char>(type));
+    }
+
+    const auto& documents = collection.getAllView();
+    std::string encoded;
+    BinaryCodec::writeVarint(collection.size(), data);
+    for(const auto& doc : documents) {
+        encoded.clear();
+        BinaryCodec::encode(doc, encoded);
+        BinaryCodec::writeString(encoded, data);
+    }
+
+    BinaryCodec::writeFixed(BinaryCodec::checksum(data), 4, data);
+
+    auto path = directory / fileName;
+    auto temporary = path;
+    temporary += ".tmp";
+
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    file.close();
+    if(!file) {
+        std::filesystem::remove(temporary);
+        throw std::runtime_error("Cannot write snapshot: " + temporary.string());
+    }
+
+    std::filesystem::rename(temporary, path);
+}
+
+std::optional<Snapshot> Snapshot::read(const std::filesystem::path& directory) {
+    auto path = directory / fileName;
+    if(!std::filesystem::exists(path)) {
+        return std::nullopt;
+    }
+
+    try {
+        MappedFile file(path);
+        auto data = file.data();
+
+        if(data.size() < header.size() + 4 || data.substr(0, header.size()) != header) {
+            throw std::runtime_error("Missing snapshot header.");
+        }
+
+        auto body = data.substr(0, data.size() - 4);
+        if(BinaryCodec::checksum(body) != BinaryCodec::Reader{data, body.size()}.fixed(4)) {
+            throw std::runtime_error("Checksum mismatch.");
+        }
+
+        Snapshot snapshot;
+        BinaryCodec::Reader reader{body, header.size()};
+        snapshot.lsn = reader.fixed(8);
+
+        auto indexCount = reader.varint();
+        for(uint64_t i{0}; i < indexCount; ++i) {
+            auto field = std::string(reader.string());
+            snapshot.indexes.emplace_back(std::move(field), static_cast<IndexType>(reader.byte()));
+        }
+
+        auto documentCount = reader.varint();
+        snapshot.documents.reserve(static_cast<size_t>(documentCount));
+        for(uint64_t i{0}; i < documentCount; ++i) {
+            snapshot.documents.push_back(BinaryCodec::decode(reader.string()));
+        }
+
+        return snapshot;
+    }
+    catch(const std::runtime_error& e) {
+        Logger::logError("Ignored damaged snapshot: " + path.string() + ": " + e.what());
+    }
+
+    return std::nullopt;
+}
+
+std::optional<uint64_t> Snapshot::readLsn(const std::filesystem::path& directory) {
+    std::string data(header.size() + 8, '\0');
+    std::ifstream file(directory / fileName, std::ios::binary);
+    if(!file.read(data.data(), static_cast<std::streamsize>(data.size())) || std::string_view(data).substr(0, header.size()) != header) {
+        return std::nullopt;
+    }
+
+    return BinaryCodec::Reader{data, header.size()}.fixed(8);
+}
+
+void Snapshot::remove(const std::filesystem::path& directory) {
+    std::filesystem::remove(directory / fileName);
+}
@@ -1,90 +1,175 @@
 #include "Storage.hpp"
 
+#include "BinaryCodec.hpp"
+#include "FileSync.hpp"
+#include "MappedFile.hpp"
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
 #include <fstream>
 #include <stdexcept>
+#include <unistd.h>
 #include <variant>
 #include <type_traits>
 #include <fstream>
 #include <string>
 
 void Storage::saveDocument(std::string collectionPath, const Document& doc) {
-    saveDocument(collectionPath, doc, 0);
+    if(_format == StorageFormat::Segment) {
+        segmentStore(collectionPath).put(doc);
+        return;
+    }
+
+    // Buffer keeps its capacity between calls, so serializing document does not allocate once it is warm
+    thread_local std::string buffer;
+    writeDocument(collectionPath, doc, _format, buffer);
 }
 
-void Storage::saveDocument(std::string collectionPath, const Document& doc, size_t tabs) {
-    
+void Storage::writeDocument(const std::string& collectionPath, const Document& doc, StorageFormat format, std::string& buffer) {
+    if(format == StorageFormat::Segment) {
+        segmentStore(collectionPath).put(doc);
+        return;
+    }
+
     auto idOpt = doc.get<size_t>("id");
     if(!idOpt) {
         throw std::runtime_error("Trying to save document without id.");
     }
 
-    auto id = *idOpt;
-    std::ofstream file(collectionPath + '/' + std::to_string(id) + ".txt");
-    if(!file.is_open()) {
-        throw std::runtime_error("Cannot open a file to save document of id: " + std::to_string(id));
+    buffer.clear();
+    if(format == StorageFormat::Text) {
+        saveSingleDocument(doc, 0, buffer);
+    }
+    else {
+        BinaryCodec::encode(doc, buffer);
     }
 
-    saveSingleDocument(doc, tabs, file);
+    writeFile(collectionPath + '/' + std::to_string(*idOpt) + extension(format), buffer);
+}
 
-    file.close();
+std::string Storage::extension(StorageFormat format) {
+    switch(format) {
+        case StorageFormat::Binary:
+            return ".bin";
+        case StorageFormat::Segment:
+            return ".seg";
+        default:
+            return ".txt";
+    }
 }
 
-void Storage::saveSingleDocument(const Document& doc, size_t tabs, std::ofstream& file) {
-    saveTabs(file, tabs);
-    file << "{\n";
+SegmentStore& Storage::segmentStore(const std::filesystem::path& collectionPath) {
+    auto key = collectionPath.lexically_normal().string();
+    std::lock_guard<std::mutex> lock(_segmentStoresMutex);
+
+    auto it = _segmentStores.find(key);
+    if(it == _segmentStores.end()) {
+        it = _segmentStores.emplace(key, std::make_shared<SegmentStore>(collectionPath)).first;
+        _compactor->track(it->second);
+    }
+
+    return *it->second;
+}
+
+bool Storage::hasSegmentStore(const std::filesystem::path& collectionPath) const {
+    {
+        std::lock_guard<std::mutex> lock(_segmentStoresMutex);
+        if(_segmentStores.count(collectionPath.lexically_normal().string()) > 0) {
+            return true;
+        }
+    }
+
+    return SegmentStore::hasSegments(collectionPath);
+}
+
+void Storage::closeCollection(const std::string& collectionPath) {
+    std::lock_guard<std::mutex> lock(_segmentStoresMutex);
+    auto it = _segmentStores.find(std::filesystem::path(collectionPath).lexically_normal().string());
+    if(it == _segmentStores.end()) {
+        return;
+    }
+
+    // Compaction running on store must not swap its result into directory which is about to be removed
+    it->second->close();
+    _segmentStores.erase(it);
+}
+
+void Storage::saveDocuments(const std::string& collectionPath, const std::vector<const Document*>& docs) {
+    if(_format == StorageFormat::Segment) {
+        segmentStore(collectionPath).put(docs);
+        return;
+    }
+
+    // Single buffer is reused by all documents, each of them is then saved with one write
+    std::string buffer;
+    for(const auto* doc : docs) {
+        writeDocument(collectionPath, *doc, _format, buffer);
+    }
+}
+
+void Storage::saveSingleDocument(const Document& doc, size_t tabs, std::string& out) {
+    saveTabs(out, tabs);
+    out += "{\n";
 
     for(const auto& pair : doc.getDataView()) {
         const auto& key = pair.first;
         const auto& val = pair.second;
 
         if(const auto* vectorType = std::get_if<Document::Vector>(&val)) {
-            saveTabs(file, tabs + 1);
-            file << key << " (Document::Vector) : [\n";
+            saveTabs(out, tabs + 1);
+            out.append(key).append(" (Document::Vector) : [\n");
             for(size_t i{0}; i < (*vectorType).size(); ++i) {
-                saveTabs(file, tabs + 2);
-                file << '[' << i << "]\n";
-                saveSingleDocument((*vectorType)[i], tabs + 2, file);
-                file << '\n';
+                saveTabs(out, tabs + 2);
+                out += '[';
+                appendNumber(out, i);
+                out += "]\n";
+                saveSingleDocument((*vectorType)[i], tabs + 2, out);
+                out += '\n';
             }
-            saveTabs(file, tabs + 1);
-            file << "]";
+            saveTabs(out, tabs + 1);
+            out += "]";
         }
         else if(const auto* mapType = std::get_if<Document::Map>(&val)) {
-            saveTabs(file, tabs + 1);
-            file << key << " (Document::Map) : {\n";
+            saveTabs(out, tabs + 1);
+            out.append(key).append(" (Document::Map) : {\n");
             for(const auto& [subkey, subdoc] : *mapType) {
-                saveTabs(file, tabs + 2);
-                file << subkey << " : \n";
-                saveSingleDocument(subdoc, tabs + 2, file);
-                file << '\n';
+                saveTabs(out, tabs + 2);
+                out.append(subkey).append(" : \n");
+                saveSingleDocument(subdoc, tabs + 2, out);
+                out += '\n';
             }
-            saveTabs(file, tabs + 1);
-            file << "}";
+            saveTabs(out, tabs + 1);
+            out += "}";
         }
         else if(const auto* documentType = std::get_if<Document>(&val)) {
-            saveTabs(file, tabs + 1);
-            file << key << " (Document)\n";
-            saveSingleDocument(*documentType, tabs + 1, file);
+            saveTabs(out, tabs + 1);
+            out.append(key).append(" (Document)\n");
+            saveSingleDocument(*documentType, tabs + 1, out);
         }
         else if(const auto* boolType = std::get_if<bool>(&val)) {
-            saveTabs(file, tabs + 1);
-            file << key << " (bool) : " << (*boolType ? "true" : "false");
+            saveTabs(out, tabs + 1);
+            out.append(key).append(" (bool) : ").append(*boolType ? "true" : "false");
         }
         else if(const auto* intType = std::get_if<int>(&val)) {
-            saveTabs(file, tabs + 1);
-            file << key << " (int) : " << *intType;
+            saveTabs(out, tabs + 1);
+            out.append(key).append(" (int) : ");
+            appendNumber(out, *intType);
         } 
         else if(const auto* doubleType = std::get_if<double>(&val)) {
-            saveTabs(file, tabs + 1);
-            file << key << " (double) : " << *doubleType;
+            saveTabs(out, tabs + 1);
+            out.append(key).append(" (double) : ");
+            appendNumber(out, *doubleType);
         } 
         else if(const auto* size_tType = std::get_if<size_t>(&val)) {
-            saveTabs(file, tabs + 1);
-            file << key << " (size_t) : " << *size_tType;
+            saveTabs(out, tabs + 1);
+            out.append(key).append(" (size_t) : ");
+            appendNumber(out, *size_tType);
         } 
         else if(const auto* stringType = std::get_if<std::string>(&val)) {
-            saveTabs(file, tabs + 1);
-            file << key << " (std::string) : " << *stringType;
+            saveTabs(out, tabs + 1);
+            out.append(key).append(" (std::string) : ").append(*stringType);
         }
         else if(auto id = doc.get<size_t>("id")) {
             throw std::runtime_error("Trying to save document with wrong wariant type in document of id: " + std::to_string(*id) + ".");
@@ -92,17 +177,47 @@ void Storage::saveSingleDocument(const Document& doc, size_t tabs, std::ofstream
         else {
             throw std::runtime_error("Trying to save document with wrong wariant type in document of unknown id.");
         }
-        file << '\n';    
+        out += '\n';    
     }
 
-    saveTabs(file, tabs);
-    file << "}";
+    saveTabs(out, tabs);
+    out += "}";
+}
+
+void Storage::syncDocuments(const std::string& collectionPath, const std::unordered_set<size_t>& ids) {
+    if(hasSegmentStore(collectionPath)) {
+        segmentStore(collectionPath).sync();
+    }
+
+    if(_format != StorageFormat::Segment) {
+        for(auto id : ids) {
+            auto path = std::filesystem::path(collectionPath) / (std::to_string(id) + extension(_format));
+            if(std::filesystem::exists(path)) {
+                syncPath(path);
+            }
+        }
+    }
+
+    // Directory keeps created and removed document files
+    syncPath(collectionPath);
 }
 
 void Storage::removeDocument(const std::filesystem::path& path, size_t id) {
-    auto filePath = path / (std::to_string(id) + ".txt");
+    if(hasSegmentStore(path) && segmentStore(path).remove(id)) {
+        Logger::logInfo("Appended tombstone of document: " + std::to_string(id) + " in: " + path.string() + ".");
+        return;
+    }
+
+    auto format = _format == StorageFormat::Segment ? StorageFormat::Text : _format;
+    auto filePath = path / (std::to_string(id) + extension(format));
 
     try {
+        // Document may still be stored in the other format if collection was not converted
+        if(!std::filesystem::exists(filePath)) {
+            auto other = format == StorageFormat::Text ? StorageFormat::Binary : StorageFormat::Text;
+            filePath = path / (std::to_string(id) + extension(other));
+        }
+
         if(std::filesystem::exists(filePath)) {
             std::filesystem::remove(filePath);
             Logger::logInfo("Deleted document file: " + filePath.string() + ".");
@@ -116,118 +231,264 @@ void Storage::removeDocument(const std::filesystem::path& path, size_t id) {
     }
 }
 
-void Storage::saveTabs(std::ofstream& file, size_t amount) {
-    for(size_t i{0}; i < amount; ++i) {
-        file << '\t';
+void Storage::saveTabs(std::string& out, size_t amount) {
+    out.append(amount, '\t');
+}
+
+template<typename Number>
+void Storage::appendNumber(std::string& out, Number value) {
+    // Same text as default formatting of streams, which is "%g" with precision 6 for floating point numbers
+    char digits[32];
+    std::to_chars_result result;
+    if constexpr(std::is_floating_point_v<Number>) {
+        result = std::to_chars(std::begin(digits), std::end(digits), value, std::chars_format::general, 6);
+    }
+    else {
+        result = std::to_chars(std::begin(digits), std::end(digits), value);
     }
+
+    out.append(digits, result.ptr);
 }
 
-std::vector<Document> Storage::loadDocuments(const std::string& collectionPath) {
-    std::vector<Document> documents;
+void Storage::writeFile(const std::filesystem::path& path, std::string_view data) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0) {
+        throw std::runtime_error("Cannot open a file to save document: " + path.string() + ": " + std::strerror(errno));
+    }
 
-    for(const auto& entry : std::filesystem::directory_iterator(collectionPath)) {
-        if(!entry.is_regular_file() || entry.path().extension() != ".txt") {
-            continue;
+    while(!data.empty()) {
+        auto written = ::write(fd, data.data(), data.size());
+        if(written < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+
+            auto error = errno;
+            ::close(fd);
+            throw std::runtime_error("Cannot write document file: " + path.string() + ": " + std::strerror(error));
         }
 
-        std::ifstream file(entry.path());
+        data.remove_prefix(static_cast<size_t>(written));
+    }
+
+    ::close(fd);
+}
 
-        if (!file.is_open()) {
-            Logger::logWarning("Could not open file: " + entry.path().string());
-            continue;
+std::vector<Document> Storage::loadDocuments(const std::string& collectionPath, Execution execution) {
+    std::vector<std::filesystem::path> paths;
+    for(const auto& entry : std::filesystem::directory_iterator(collectionPath)) {
+        if(entry.is_regular_file()) {
+            paths.push_back(entry.path());
+        }
+    }
+
+    // Every file is parsed into its own slot, so threads never share written data
+    std::vector<std::optional<Document>> loaded(paths.size());
+    auto parse = [&](size_t, size_t begin, size_t end) {
+        for(size_t i{begin}; i < end; ++i) {
+            loaded[i] = loadDocument(paths[i]);
         }
+    };
 
-        try {
-            documents.push_back(parseDocument(file));
-        } catch (const std::exception& e) {
-            Logger::logError("Failed to parse document " + entry.path().string() + ": " + e.what());
+    auto& pool = ThreadPool::shared();
+    if(execution == Execution::Sequential || paths.size() < 2) {
+        parse(0, 0, paths.size());
+    }
+    else {
+        pool.parallelFor(paths.size(), (pool.size() + 1) * 4, parse);
+    }
+
+    std::vector<Document> documents;
+    documents.reserve(paths.size());
+    for(auto& doc : loaded) {
+        if(doc) {
+            documents.push_back(std::move(*doc));
         }
     }
 
+    if(hasSegmentStore(collectionPath)) {
+        auto stored = segmentStore(collectionPath).load();
+        documents.insert(documents.end(), std::make_move_iterator(stored.begin()), std::make_move_iterator(stored.end()));
+    }
+
     return documents;
 }
 
-std::string Storage::trim(const std::string& source) {
-    std::string trimmed(source);
-    trimmed.erase(0, trimmed.find_first_not_of(" \n\r\t"));
-    trimmed.erase(trimmed.find_last_not_of(" \n\r\t") + 1);
-    return trimmed;
-}
+std::optional<Document> Storage::loadDocument(const std::filesystem::path& path) {
+    auto fileExtension = path.extension();
+    if(fileExtension != extension(StorageFormat::Text) && fileExtension != extension(StorageFormat::Binary)) {
+        return std::nullopt;
+    }
+
+    bool binary = fileExtension == extension(StorageFormat::Binary);
 
-std::string Storage::parseKey(const std::string& trimmed) {
-    std::string key(trimmed);
-    key.erase(key.find_first_of(" \n\r\t") + 1);
-    return trim(key);
+    std::optional<MappedFile> file;
+    try {
+        file.emplace(path);
+    } catch (const std::runtime_error& e) {
+        Logger::logWarning("Could not open file: " + path.string());
+        return std::nullopt;
+    }
+
+    try {
+        // Parsers work directly on mapped pages, text parser only slices views of them
+        if(!binary) {
+            auto text = file->data();
+            return parseDocument(text);
+        }
+
+        return BinaryCodec::decode(file->data());
+    } catch (const std::exception& e) {
+        Logger::logError("Failed to parse document " + path.string() + ": " + e.what());
+    }
+
+    return std::nullopt;
 }
 
-std::string Storage::parseType(const std::string& trimmed) {
-    if(trimmed.empty()) {
-        return std::string();
+void Storage::convertCollection(const std::string& collectionPath, StorageFormat format) {
+    std::vector<std::filesystem::path> converted;
+    for(const auto& entry : std::filesystem::directory_iterator(collectionPath)) {
+        if(entry.is_regular_file() && entry.path().extension() != extension(format) && !SegmentStore::isSegment(entry.path())) {
+            converted.push_back(entry.path());
+        }
     }
 
-    std::string type(trimmed);
-    type.erase(0, type.find_first_of(" \n\r\t") + 1);
+    std::string buffer;
+    size_t count{0};
 
-    switch(type[0]) {
-        case '{':
-        case '}':
-        case '[':
-        case ']':
-        case ':':
-            return std::string();
+    if(format == StorageFormat::Segment) {
+        std::vector<Document> docs;
+        std::vector<std::filesystem::path> loaded;
+        for(const auto& path : converted) {
+            if(auto doc = loadDocument(path)) {
+                docs.push_back(std::move(*doc));
+                loaded.push_back(path);
+            }
+        }
+
+        std::vector<const Document*> pointers;
+        pointers.reserve(docs.size());
+        for(const auto& doc : docs) {
+            pointers.push_back(&doc);
+        }
+
+        segmentStore(collectionPath).put(pointers);
+        for(const auto& path : loaded) {
+            std::filesystem::remove(path);
+        }
+        count = loaded.size();
+    }
+    else {
+        for(const auto& path : converted) {
+            auto doc = loadDocument(path);
+            if(!doc) {
+                continue;
+            }
+
+            writeDocument(collectionPath, *doc, format, buffer);
+            std::filesystem::remove(path);
+            ++count;
+        }
+
+        if(hasSegmentStore(collectionPath)) {
+            auto& store = segmentStore(collectionPath);
+            for(const auto& doc : store.load()) {
+                writeDocument(collectionPath, doc, format, buffer);
+                ++count;
+            }
+            store.clear();
+            closeCollection(collectionPath);
+        }
     }
 
-    type.erase(0, 1);
-    type.erase(type.find_first_of(")"));
+    Logger::logInfo("Converted " + std::to_string(count) + " document file(s) in: " + collectionPath + ".");
+}
 
-    return type;
+std::string_view Storage::trim(std::string_view source) {
+    auto begin = source.find_first_not_of(" \n\r\t");
+    if(begin == std::string_view::npos) {
+        return std::string_view();
+    }
+
+    return source.substr(begin, source.find_last_not_of(" \n\r\t") + 1 - begin);
 }
 
-std::string Storage::parseValue(const std::string& trimmed) {
-    std::string value(trimmed);
-    value.erase(0, value.find_first_of(")") + 1);
-    value.erase(0, value.find_first_of(":") + 1);
-    value.erase(0, value.find_first_of(" ") + 1);
-    return value;
+std::string_view Storage::nextLine(std::string_view& text) {
+    auto end = text.find('\n');
+    auto line = text.substr(0, end);
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    return trim(line);
 }
 
-char Storage::parseSpecial(const std::string& trimmed) {
-    if(trimmed.empty()) {
-        return '\0';
+std::string_view Storage::parseKey(std::string_view trimmed) {
+    auto end = trimmed.find_first_of(" \n\r\t");
+    if(end == std::string_view::npos) {
+        return std::string_view();
     }
 
-    std::string special(trimmed);
+    return trimmed.substr(0, end);
+}
+
+std::string_view Storage::parseType(std::string_view trimmed) {
+    auto begin = trimmed.find_first_of(" \n\r\t");
+    auto type = begin == std::string_view::npos ? trimmed : trimmed.substr(begin + 1);
+    if(type.empty()) {
+        return type;
+    }
 
-    switch(special[0]) {
+    switch(type[0]) {
         case '{':
         case '}':
         case '[':
         case ']':
         case ':':
-            return special[0];
-        default:
-            return '\0';
+            return std::string_view();
+    }
+
+    type.remove_prefix(1);
+    return type.substr(0, type.find(')'));
+}
+
+std::string_view Storage::parseValue(std::string_view trimmed) {
+    auto skipPast = [&trimmed](char c) {
+        auto pos = trimmed.find(c);
+        trimmed.remove_prefix(pos == std::string_view::npos ? 0 : pos + 1);
+    };
+
+    skipPast(')');
+    skipPast(':');
+    skipPast(' ');
+    return trimmed;
+}
+
+template<typename Number>
+Number Storage::parseNumber(std::string_view value) {
+    Number number{};
+    auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+    if(error != std::errc()) {
+        throw std::runtime_error("Invalid number: " + std::string(value) + ".");
     }
+
+    return number;
 }
 
-bool Storage::isDocumentStart(const std::string& trimmed, std::string& key, const std::string& type) {
+bool Storage::isDocumentStart(std::string_view trimmed, std::string_view key, std::string_view type) {
     return !trimmed.empty() && !key.empty() && type == "Document";
 }
 
-bool Storage::isVectorStart(const std::string& trimmed, const std::string& key, const std::string& type) {
-    return !key.empty() && type == "Document::Vector" && trimmed[trimmed.size() - 1] == '[';
+bool Storage::isVectorStart(std::string_view trimmed, std::string_view key, std::string_view type) {
+    return !key.empty() && type == "Document::Vector" && trimmed.back() == '[';
 }
 
-bool Storage::isMapStart(const std::string& trimmed, const std::string& key, const std::string& type) {
-    return !key.empty() && type == "Document::Map" && trimmed[trimmed.size() - 1] == '{';
+bool Storage::isMapStart(std::string_view trimmed, std::string_view key, std::string_view type) {
+    return !key.empty() && type == "Document::Map" && trimmed.back() == '{';
 }
 
-Document Storage::parseDocument(std::ifstream& file) {
+Document Storage::parseDocument(std::string_view& text) {
     Document doc;
-    std::string line;
 
-    while (std::getline(file, line)) {
-        auto trimmed = trim(line);
+    while (!text.empty()) {
+        auto trimmed = nextLine(text);
 
         if (trimmed.empty()) {
             continue;
@@ -239,35 +500,36 @@ Document Storage::parseDocument(std::ifstream& file) {
 
         auto key = parseKey(trimmed);
         auto type = parseType(trimmed);
-        auto value = parseValue(trimmed);
 
         if (isDocumentStart(trimmed, key, type)) {
-            auto nestedDoc = parseDocument(file);
-            doc.set(key, std::move(nestedDoc));
+            auto nestedDoc = parseDocument(text);
+            doc.set(std::string(key), std::move(nestedDoc));
         }
         else if (isVectorStart(trimmed, key, type)) {
-            auto vector = parseVector(file);
-            doc.set(key, std::move(vector));
+            auto vector = parseVector(text);
+            doc.set(std::string(key), std::move(vector));
         }
         else if (isMapStart(trimmed, key, type)) {
-            auto map = parseMap(file);
-            doc.set(key, std::move(map));
+            auto map = parseMap(text);
+            doc.set(std::string(key), std::move(map));
         }
         else if (!key.empty() && !type.empty()) {
+            auto value = parseValue(trimmed);
+
             if (type == "bool") {
-                doc.set(key, value == "true");
+                doc.set(std::string(key), value == "true");
             }
             else if (type == "int") {
-                doc.set(key, std::stoi(value));
+                doc.set(std::string(key), parseNumber<int>(value));
             }
             else if (type == "double") {
-                doc.set(key, std::stod(value));
+                doc.set(std::string(key), parseNumber<double>(value));
             }
             else if (type == "size_t") {
-                doc.set(key, static_cast<size_t>(std::stoull(value)));
+                doc.set(std::string(key), parseNumber<size_t>(value));
             }
             else if (type == "std::string") {
-                doc.set(key, value);
+                doc.set(std::string(key), std::string(value));
             }
         }
     }
@@ -275,12 +537,11 @@ Document Storage::parseDocument(std::ifstream& file) {
     return doc;
 }
 
-Document::Vector Storage::parseVector(std::ifstream& file) {
+Document::Vector Storage::parseVector(std::string_view& text) {
     Document::Vector vector;
-    std::string line;
 
-    while (std::getline(file, line)) {
-        auto trimmed = trim(line);
+    while (!text.empty()) {
+        auto trimmed = nextLine(text);
 
         if (trimmed.empty()) {
             continue;
@@ -295,20 +556,18 @@ Document::Vector Storage::parseVector(std::ifstream& file) {
         }
 
         if (trimmed == "{") {
-            vector.emplace_back(parseDocument(file));
+            vector.emplace_back(parseDocument(text));
         }
     }
 
     return vector;
 }
 
-Document::Map Storage::parseMap(std::ifstream& file) {
+Document::Map Storage::parseMap(std::string_view& text) {
     Document::Map map;
-    std::string line;
-    std::string current_key;
 
-    while (std::getline(file, line)) {
-        auto trimmed = trim(line);
+    while (!text.empty()) {
+        auto trimmed = nextLine(text);
 
         if (trimmed.empty()) {
             continue;
@@ -319,12 +578,10 @@ Document::Map Storage::parseMap(std::ifstream& file) {
         }
 
         auto colon_pos = trimmed.find(':');
-        if (colon_pos != std::string::npos) {
-            current_key = trim(trimmed.substr(0, colon_pos));
-            std::getline(file, line);
-            trimmed = trim(line);
-            if (trimmed == "{") {
-                map[current_key] = parseDocument(file);
+        if (colon_pos != std::string_view::npos) {
+            auto current_key = trim(trimmed.substr(0, colon_pos));
+            if (nextLine(text) == "{") {
+                map[std::string(current_key)] = parseDocument(text);
             }
         }
     }
@@ -0,0 +1,56 @@
+#include "ThreadPool.hpp"
+
+ThreadPool::ThreadPool(size_t threads) {
+    threads = std::max<size_t>(threads, 1);
+
+    _workers.reserve(threads);
+    for(size_t i{0}; i < threads; ++i) {
+        _workers.emplace_back([this]() { work(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+
+    _available.notify_all();
+    for(auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(std::thread::hardware_concurrency());
+    return pool;
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push(std::move(task));
+    }
+
+    _available.notify_one();
+}
+
+void ThreadPool::work() {
+    for(;;) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _available.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+
+            if(_tasks.empty()) {
+                return;
+            }
+
+            task = std::move(_tasks.front());
+            _tasks.pop();
+        }
+
+        task();
+    }
+}
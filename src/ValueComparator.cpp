@@ -0,0 +1,201 @@
+#include "ValueComparator.hpp"
+
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace {
+
+/// @brief Integral number which fits in long long or size_t
+struct Integral {
+    bool negative;
+    size_t magnitude;
+};
+
+/// @brief Convert numeric value to integral if it represents whole number
+std::optional<Integral> toIntegral(const Document::Value& value) {
+    if(const auto* intType = std::get_if<int>(&value)) {
+        if(*intType < 0) {
+            return Integral{true, static_cast<size_t>(-static_cast<long long>(*intType))};
+        }
+        return Integral{false, static_cast<size_t>(*intType)};
+    }
+    if(const auto* size_tType = std::get_if<size_t>(&value)) {
+        return Integral{false, *size_tType};
+    }
+    if(const auto* doubleType = std::get_if<double>(&value)) {
+        double d = *doubleType;
+        if(!std::isfinite(d) || std::trunc(d) != d) {
+            return std::nullopt;
+        }
+        // 2^64 is exactly representable, every smaller whole double fits in size_t
+        constexpr double limit = 18446744073709551616.0;
+        if(d >= limit || d <= -limit) {
+            return std::nullopt;
+        }
+        if(d < 0) {
+            return Integral{true, static_cast<size_t>(-d)};
+        }
+        return Integral{false, static_cast<size_t>(d)};
+    }
+    return std::nullopt;
+}
+
+/// @brief Compare integral numbers
+int compareIntegral(const Integral& lhs, const Integral& rhs) {
+    bool lhsNegative = lhs.negative && lhs.magnitude != 0;
+    bool rhsNegative = rhs.negative && rhs.magnitude != 0;
+
+    if(lhsNegative != rhsNegative) {
+        return lhsNegative ? -1 : 1;
+    }
+
+    if(lhs.magnitude == rhs.magnitude) {
+        return 0;
+    }
+
+    bool lhsSmaller = lhs.magnitude < rhs.magnitude;
+    return (lhsSmaller != lhsNegative) ? -1 : 1;
+}
+
+/// @brief Compare integral number with double which is not whole or exceeds integral range
+std::optional<int> compareIntegralWithDouble(const Integral& lhs, double rhs) {
+    if(std::isnan(rhs)) {
+        return std::nullopt;
+    }
+
+    auto floor = toIntegral(std::floor(rhs));
+    if(!floor) {
+        return rhs > 0 ? -1 : 1;
+    }
+
+    // rhs lies strictly between floor and floor + 1
+    return compareIntegral(lhs, *floor) <= 0 ? -1 : 1;
+}
+
+/// @brief Compare numeric values
+std::optional<int> compareNumbers(const Document::Value& lhs, const Document::Value& rhs) {
+    auto lhsIntegral = toIntegral(lhs);
+    auto rhsIntegral = toIntegral(rhs);
+
+    if(lhsIntegral && rhsIntegral) {
+        return compareIntegral(*lhsIntegral, *rhsIntegral);
+    }
+
+    if(lhsIntegral) {
+        return compareIntegralWithDouble(*lhsIntegral, std::get<double>(rhs));
+    }
+
+    if(rhsIntegral) {
+        auto result = compareIntegralWithDouble(*rhsIntegral, std::get<double>(lhs));
+        if(!result) {
+            return std::nullopt;
+        }
+        return -*result;
+    }
+
+    double lhsDouble = std::get<double>(lhs);
+    double rhsDouble = std::get<double>(rhs);
+    if(std::isnan(lhsDouble) || std::isnan(rhsDouble)) {
+        return std::nullopt;
+    }
+
+    return (lhsDouble < rhsDouble) ? -1 : (lhsDouble > rhsDouble ? 1 : 0);
+}
+
+}
+
+bool ValueComparator::isOrderable(const Document::Value& value) {
+    if(const auto* doubleType = std::get_if<double>(&value)) {
+        return !std::isnan(*doubleType);
+    }
+
+    return isNumeric(value) || std::holds_alternative<std::string>(value);
+}
+
+std::optional<int> ValueComparator::compare(const Document::Value& lhs, const Document::Value& rhs) {
+    if(isNumeric(lhs) && isNumeric(rhs)) {
+        return compareNumbers(lhs, rhs);
+    }
+
+    const auto* lhsString = std::get_if<std::string>(&lhs);
+    const auto* rhsString = std::get_if<std::string>(&rhs);
+    if(lhsString && rhsString) {
+        int result = lhsString->compare(*rhsString);
+        return (result < 0) ? -1 : (result > 0 ? 1 : 0);
+    }
+
+    const auto* lhsBool = std::get_if<bool>(&lhs);
+    const auto* rhsBool = std::get_if<bool>(&rhs);
+    if(lhsBool && rhsBool) {
+        return static_cast<int>(*lhsBool) - static_cast<int>(*rhsBool);
+    }
+
+    return std::nullopt;
+}
+
+int ValueComparator::order(const Document::Value& lhs, const Document::Value& rhs) {
+    bool lhsNumeric = isNumeric(lhs);
+    bool rhsNumeric = isNumeric(rhs);
+
+    if(lhsNumeric != rhsNumeric) {
+        return lhsNumeric ? -1 : 1;
+    }
+
+    return compare(lhs, rhs).value_or(0);
+}
+
+bool ValueComparator::isNumeric(const Document::Value& value) {
+    return std::holds_alternative<int>(value) ||
+        std::holds_alternative<size_t>(value) ||
+        std::holds_alternative<double>(value);
+}
+
+bool ValueComparator::isScalar(const Document::Value& value) {
+    return isNumeric(value) ||
+        std::holds_alternative<std::string>(value) ||
+        std::holds_alternative<bool>(value);
+}
+
+bool ValueComparator::equal(const Document::Value& lhs, const Document::Value& rhs) {
+    if(!isNumeric(lhs) || !isNumeric(rhs)) {
+        return lhs == rhs;
+    }
+
+    auto lhsIntegral = toIntegral(lhs);
+    auto rhsIntegral = toIntegral(rhs);
+    if(lhsIntegral && rhsIntegral) {
+        if(lhsIntegral->magnitude == 0 && rhsIntegral->magnitude == 0) {
+            return true;
+        }
+        return lhsIntegral->negative == rhsIntegral->negative && lhsIntegral->magnitude == rhsIntegral->magnitude;
+    }
+
+    // At least one of values is double which is not whole, so other one must be the same double
+    const auto* lhsDouble = std::get_if<double>(&lhs);
+    const auto* rhsDouble = std::get_if<double>(&rhs);
+    return lhsDouble && rhsDouble && *lhsDouble == *rhsDouble;
+}
+
+size_t ValueComparator::hash(const Document::Value& value) {
+    if(isNumeric(value)) {
+        if(auto integral = toIntegral(value)) {
+            if(integral->negative && integral->magnitude != 0) {
+                return std::hash<size_t>{}(integral->magnitude) ^ 0x9e3779b97f4a7c15ull;
+            }
+            return std::hash<size_t>{}(integral->magnitude);
+        }
+        return std::hash<double>{}(std::get<double>(value));
+    }
+
+    if(const auto* stringType = std::get_if<std::string>(&value)) {
+        return std::hash<std::string>{}(*stringType);
+    }
+
+    if(const auto* boolType = std::get_if<bool>(&value)) {
+        return std::hash<bool>{}(*boolType);
+    }
+
+    // Nested documents and containers are not indexable, they share one bucket
+    return value.index();
+}
@@ -0,0 +1,290 @@
+#include "WriteAheadLog.hpp"
+
+#include "BinaryCodec.hpp"
+#include "Logger.hpp"
+#include "ThreadPool.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <unistd.h>
+
+WriteAheadLog::WriteAheadLog(std::filesystem::path path, SyncPolicy policy, std::chrono::milliseconds syncInterval, uint64_t initialLsn)
+    : _path(std::move(path)), _policy(policy), _syncInterval(syncInterval) {
+    _fd = ::open(_path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if(_fd < 0) {
+        throw std::runtime_error("Cannot open write-ahead log: " + _path.string() + ": " + std::strerror(errno));
+    }
+
+    std::string data(static_cast<size_t>(std::filesystem::file_size(_path)), '\0');
+    std::ifstream(_path, std::ios::binary).read(data.data(), static_cast<std::streamsize>(data.size()));
+
+    size_t end{headerSize};
+    if(data.size() < headerSize) {
+        _base = initialLsn;
+
+        std::string header(magic);
+        BinaryCodec::writeFixed(_base, 8, header);
+
+        if(::ftruncate(_fd, 0) != 0) {
+            throw std::runtime_error("Cannot truncate write-ahead log: " + _path.string() + ".");
+        }
+        writeAll(header);
+    }
+    else {
+        if(std::string_view(data).substr(0, magic.size()) != magic) {
+            throw std::runtime_error("File is not write-ahead log: " + _path.string() + ".");
+        }
+
+        _base = BinaryCodec::Reader{data, magic.size()}.fixed(8);
+
+        while(data.size() - end >= 8) {
+            auto size = BinaryCodec::Reader{data, end}.fixed(4);
+            auto expected = static_cast<uint32_t>(BinaryCodec::Reader{data, end + 4}.fixed(4));
+            if(data.size() - end - 8 < size || BinaryCodec::checksum(std::string_view(data).substr(end + 8, size)) != expected) {
+                break;
+            }
+
+            end += 8 + size;
+        }
+
+        // Records appended after torn tail would never be reached, so it is cut off
+        if(end < data.size()) {
+            Logger::logWarning("Ignored " + std::to_string(data.size() - end) + " damaged byte(s) at the end of write-ahead log: " + _path.string() + ".");
+            if(::ftruncate(_fd, static_cast<off_t>(end)) != 0) {
+                throw std::runtime_error("Cannot truncate write-ahead log: " + _path.string() + ".");
+            }
+        }
+    }
+
+    _committed = _written = _synced = _base + (end - headerSize);
+
+    if(_policy == SyncPolicy::Interval) {
+        _syncThread = std::thread([this]() { syncPeriodically(); });
+    }
+}
+
+WriteAheadLog::~WriteAheadLog() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+
+    _condition.notify_all();
+    if(_syncThread.joinable()) {
+        _syncThread.join();
+    }
+
+    if(_policy != SyncPolicy::Never && !_failed && _written > _synced) {
+        ::fsync(_fd);
+    }
+
+    ::close(_fd);
+}
+
+std::vector<WalRecord> WriteAheadLog::read() const {
+    std::string data(static_cast<size_t>(std::filesystem::file_size(_path)), '\0');
+    std::ifstream(_path, std::ios::binary).read(data.data(), static_cast<std::streamsize>(data.size()));
+
+    std::vector<WalRecord> records;
+    size_t pos{headerSize};
+    while(data.size() - pos >= 8) {
+        auto size = static_cast<size_t>(BinaryCodec::Reader{data, pos}.fixed(4));
+        auto expected = static_cast<uint32_t>(BinaryCodec::Reader{data, pos + 4}.fixed(4));
+        auto body = std::string_view(data).substr(pos + 8, size);
+        if(body.size() < size || BinaryCodec::checksum(body) != expected) {
+            break;
+        }
+
+        pos += 8 + size;
+
+        BinaryCodec::Reader reader{body};
+        WalRecord record;
+        record.lsn = _base + (pos - headerSize);
+        record.type = static_cast<WalRecord::Type>(reader.byte());
+        record.collection = std::string(reader.string());
+        record.id = static_cast<size_t>(reader.fixed(8));
+        if(record.type == WalRecord::Type::Put) {
+            record.doc = BinaryCodec::decode(body.substr(reader.pos));
+        }
+
+        records.push_back(std::move(record));
+    }
+
+    return records;
+}
+
+uint64_t WriteAheadLog::logPuts(const std::string& collection, const std::vector<const Document*>& docs) {
+    std::string records;
+    for(const auto* doc : docs) {
+        auto idOpt = doc->get<size_t>("id");
+        if(!idOpt) {
+            throw std::runtime_error("Trying to log document without id.");
+        }
+
+        encodeRecord(WalRecord::Type::Put, collection, *idOpt, doc, records);
+    }
+
+    return commit(records);
+}
+
+uint64_t WriteAheadLog::logRemoves(const std::string& collection, const std::vector<size_t>& ids) {
+    std::string records;
+    for(auto id : ids) {
+        encodeRecord(WalRecord::Type::Remove, collection, id, nullptr, records);
+    }
+
+    return commit(records);
+}
+
+void WriteAheadLog::reset() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait(lock, [this]() { return _failed || (!_writing && _pending.empty()); });
+
+    if(_failed) {
+        throw std::runtime_error("Write-ahead log: " + _path.string() + " failed earlier.");
+    }
+
+    std::string header(magic);
+    BinaryCodec::writeFixed(_committed, 8, header);
+
+    if(::ftruncate(_fd, 0) != 0) {
+        throw std::runtime_error("Cannot truncate write-ahead log: " + _path.string() + ".");
+    }
+    writeAll(header);
+    if(_policy != SyncPolicy::Never) {
+        sync();
+    }
+
+    _base = _committed;
+    _written = _synced = _committed;
+}
+
+uint64_t WriteAheadLog::getLsn() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _committed;
+}
+
+uint64_t WriteAheadLog::size() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return headerSize + (_committed - _base);
+}
+
+uint64_t WriteAheadLog::commit(const std::string& records) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if(_failed) {
+        throw std::runtime_error("Write-ahead log: " + _path.string() + " failed earlier.");
+    }
+
+    _pending.append(records);
+    _committed += records.size();
+    auto lsn = _committed;
+
+    auto durable = [this, lsn]() { return (_policy == SyncPolicy::Always ? _synced : _written) >= lsn; };
+
+    for(;;) {
+        _condition.wait(lock, [&]() { return _failed || durable() || !_writing; });
+
+        if(durable()) {
+            return lsn;
+        }
+
+        if(_failed) {
+            throw std::runtime_error("Write-ahead log: " + _path.string() + " failed while committing.");
+        }
+
+        // First thread to find log idle writes records of all threads which arrived meanwhile
+        _writing = true;
+        std::string batch;
+        batch.swap(_pending);
+        auto end = _committed;
+        lock.unlock();
+
+        try {
+            writeAll(batch);
+            if(_policy == SyncPolicy::Always) {
+                sync();
+            }
+        }
+        catch(...) {
+            lock.lock();
+            _failed = true;
+            _writing = false;
+            _condition.notify_all();
+            throw;
+        }
+
+        lock.lock();
+        _writing = false;
+        _written = end;
+        if(_policy == SyncPolicy::Always) {
+            _synced = end;
+        }
+        _condition.notify_all();
+    }
+}
+
+void WriteAheadLog::encodeRecord(WalRecord::Type type, const std::string& collection, size_t id, const Document* doc, std::string& out) {
+    size_t start = out.size();
+    out.append(8, '\0');
+
+    out.push_back(static_cast<char>(type));
+    BinaryCodec::writeString(collection, out);
+    BinaryCodec::writeFixed(id, 8, out);
+    if(doc) {
+        BinaryCodec::encode(*doc, out);
+    }
+
+    std::string prefix;
+    auto body = std::string_view(out).substr(start + 8);
+    BinaryCodec::writeFixed(body.size(), 4, prefix);
+    BinaryCodec::writeFixed(BinaryCodec::checksum(body), 4, prefix);
+    out.replace(start, prefix.size(), prefix);
+}
+
+void WriteAheadLog::writeAll(std::string_view data) {
+    while(!data.empty()) {
+        auto written = ::write(_fd, data.data(), data.size());
+        if(written < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Cannot write write-ahead log: " + _path.string() + ": " + std::strerror(errno));
+        }
+
+        data.remove_prefix(static_cast<size_t>(written));
+    }
+}
+
+void WriteAheadLog::sync() {
+    if(::fsync(_fd) != 0) {
+        throw std::runtime_error("Cannot sync write-ahead log: " + _path.string() + ": " + std::strerror(errno));
+    }
+}
+
+void WriteAheadLog::syncPeriodically() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    for(;;) {
+        if(_condition.wait_for(lock, _syncInterval, [this]() { return _stopping; })) {
+            return;
+        }
+
+        auto target = _written;
+        if(target <= _synced || _failed) {
+            continue;
+        }
+
+        lock.unlock();
+        try {
+            sync();
+        }
+        catch(const std::exception& e) {
+            Logger::logError(e.what());
+        }
+        lock.lock();
+
+        _synced = std::max(_synced, target);
+    }
+}
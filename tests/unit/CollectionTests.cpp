@@ -367,6 +367,18 @@ TEST_F(CollectionTest, RemoveDocument_WhenIdIsValid_RemoveDocument) {
     }
 }
 
+TEST_F(CollectionTest, RemoveDocument_WhenDocumentIsNotLast_MovesLastDocumentIntoItsPlace) {
+    auto docs = collection.getAll();
+    ASSERT_EQ(docs.size(), 3u);
+
+    collection.remove(docs[0]);
+
+    auto docsAfter = collection.getAll();
+    ASSERT_EQ(docsAfter.size(), 2u);
+    EXPECT_EQ(docsAfter[0], docs[2]);
+    EXPECT_EQ(docsAfter[1], docs[1]);
+}
+
 TEST_F(CollectionTest, RemoveDocument_WhenIdIsNotValid_DoNothing) {
     // Create a document with a random id not in the collection
     Document doc;
@@ -588,4 +600,620 @@ TEST_F(CollectionTest, GetDocumentById_ReturnsCorrectDocument) {
 TEST_F(CollectionTest, GetDocumentById_NonExistentId_ReturnsNullopt) {
     auto result = collection.getDocumentById(999999);
     EXPECT_FALSE(result.has_value());
-}
\ No newline at end of file
+}
+
+TEST_F(CollectionTest, GetDocumentById_AfterRemovingOtherDocument_ReturnsCorrectDocument) {
+    auto docs = collection.getAll();
+    ASSERT_EQ(docs.size(), 3u);
+    collection.remove(docs[0]);
+
+    for (size_t i = 1; i < docs.size(); ++i) {
+        auto found = collection.getDocumentById(*docs[i].get<size_t>("id"));
+        ASSERT_TRUE(found.has_value());
+        EXPECT_EQ(found->get<std::string>("name"), docs[i].get<std::string>("name"));
+    }
+    EXPECT_FALSE(collection.getDocumentById(*docs[0].get<size_t>("id")).has_value());
+}
+
+TEST_F(CollectionTest, GetDocumentById_AfterRemovingByFilter_ReturnsCorrectDocument) {
+    collection.remove([](const Document& doc) {
+        return doc.get<int>("number") == std::optional<int>(1);
+    });
+
+    for (const auto& doc : collection.getAll()) {
+        auto id = *doc.get<size_t>("id");
+        Document updated = doc;
+        updated.set("name", std::string("updated"));
+        collection.update(updated);
+
+        auto found = collection.getDocumentById(id);
+        ASSERT_TRUE(found.has_value());
+        EXPECT_EQ(found->get<std::string>("name"), std::optional<std::string>("updated"));
+    }
+}
+
+// -------------------- Tests: findEqual / createIndex --------------------
+
+TEST_F(CollectionTest, FindEqual_WhenFieldIsIndexed_ReturnsMatchingDocuments) {
+    collection.createIndex("name");
+    ASSERT_TRUE(collection.hasIndex("name"));
+
+    auto results = collection.findEqual("name", std::string("test_2"));
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].get<int>("number"), std::optional<int>(2));
+    EXPECT_TRUE(collection.findEqual("name", std::string("missing")).empty());
+}
+
+TEST_F(CollectionTest, FindEqual_WhenFieldIsNotIndexed_ScansDocuments) {
+    auto results = collection.findEqual("number", 3);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].get<std::string>("name"), std::optional<std::string>("test_3"));
+}
+
+TEST_F(CollectionTest, FindEqual_NumericAlternativesAreComparedByValue) {
+    collection.createIndex("number");
+
+    EXPECT_EQ(collection.findEqual("number", static_cast<size_t>(1)).size(), 1u);
+    EXPECT_EQ(collection.findEqual("number", 2.0).size(), 1u);
+    EXPECT_TRUE(collection.findEqual("number", 2.5).empty());
+}
+
+TEST_F(CollectionTest, CreateIndex_StaysInSyncAfterUpdateAndRemove) {
+    collection.createIndex("number");
+
+    collection.update(
+        [](const Document& doc) { return doc.get<int>("number") == std::optional<int>(1); },
+        [](Document& doc) { doc.set("number", 10); }
+    );
+    EXPECT_TRUE(collection.findEqual("number", 1).empty());
+    ASSERT_EQ(collection.findEqual("number", 10).size(), 1u);
+
+    auto doc = collection.findEqual("number", 2)[0];
+    doc.set("number", 20);
+    collection.update(doc);
+    EXPECT_TRUE(collection.findEqual("number", 2).empty());
+    EXPECT_EQ(collection.findEqual("number", 20).size(), 1u);
+
+    collection.remove(doc);
+    EXPECT_TRUE(collection.findEqual("number", 20).empty());
+
+    collection.remove([](const Document&) { return true; });
+    EXPECT_TRUE(collection.findEqual("number", 10).empty());
+}
+
+// -------------------- Tests: findRange / findPrefix --------------------
+
+TEST_F(CollectionTest, FindRange_WhenFieldIsIndexed_ReturnsOrderedDocumentsInRange) {
+    Collection col("RangeTest");
+    for (int i = 0; i < 30; ++i) {
+        Document doc;
+        doc.set("age", 29 - i);
+        col.insert(doc);
+    }
+    col.createIndex("age", IndexType::Ordered);
+    ASSERT_TRUE(col.hasIndex("age", IndexType::Ordered));
+
+    auto results = col.findRange("age", Bound{10, true}, Bound{20, false});
+    ASSERT_EQ(results.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(results[i].get<int>("age"), std::optional<int>(10 + i));
+    }
+}
+
+TEST_F(CollectionTest, FindRange_WhenDocumentsTieOnKey_ReturnsSameOrderWithAndWithoutIndex) {
+    Collection col("RangeTest");
+    for (int i = 0; i < 50; ++i) {
+        Document doc;
+        doc.set("age", i % 3);
+        doc.set("name", std::string("name") + std::to_string(i % 2));
+        doc.set("order", i);
+        col.insert(doc);
+    }
+
+    auto scannedRange = col.findRange("age", Bound{0, true}, Bound{1, true});
+    auto scannedPrefix = col.findPrefix("name", "name");
+    auto scannedEqual = col.findEqual("age", 1);
+
+    col.createIndex("age", IndexType::Ordered);
+    col.createIndex("name", IndexType::Ordered);
+    EXPECT_EQ(col.findRange("age", Bound{0, true}, Bound{1, true}), scannedRange);
+    EXPECT_EQ(col.findPrefix("name", "name"), scannedPrefix);
+
+    col.createIndex("age", IndexType::Hash);
+    EXPECT_EQ(col.findEqual("age", 1), scannedEqual);
+}
+
+TEST_F(CollectionTest, FindRange_MixedNumericTypesCompareConsistently) {
+    Collection col("RangeTest");
+    Document a, b, c, d;
+    a.set("value", 1);
+    b.set("value", static_cast<size_t>(2));
+    c.set("value", 2.5);
+    d.set("value", std::string("3"));
+    col.insert(a);
+    col.insert(b);
+    col.insert(c);
+    col.insert(d);
+
+    auto scanned = col.findRange("value", Bound{1.5, true}, std::nullopt);
+    col.createIndex("value", IndexType::Ordered);
+    auto indexed = col.findRange("value", Bound{1.5, true}, std::nullopt);
+
+    for (const auto& results : {scanned, indexed}) {
+        ASSERT_EQ(results.size(), 2u);
+        EXPECT_EQ(results[0].get<size_t>("value"), std::optional<size_t>(2));
+        EXPECT_EQ(results[1].get<double>("value"), std::optional<double>(2.5));
+    }
+}
+
+TEST_F(CollectionTest, FindRange_StaysInSyncAfterUpdate) {
+    collection.createIndex("number", IndexType::Ordered);
+    collection.update(
+        [](const Document& doc) { return doc.get<int>("number") == std::optional<int>(3); },
+        [](Document& doc) { doc.set("number", -3); }
+    );
+
+    auto results = collection.findRange("number", std::nullopt, Bound{2, true});
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_EQ(results[0].get<int>("number"), std::optional<int>(-3));
+    EXPECT_EQ(results[2].get<int>("number"), std::optional<int>(2));
+}
+
+TEST_F(CollectionTest, FindPrefix_ReturnsOrderedDocumentsWithPrefix) {
+    Document other;
+    other.set("name", std::string("other"));
+    collection.insert(other);
+
+    auto scanned = collection.findPrefix("name", "test_");
+    collection.createIndex("name", IndexType::Ordered);
+    auto indexed = collection.findPrefix("name", "test_");
+
+    for (const auto& results : {scanned, indexed}) {
+        ASSERT_EQ(results.size(), 3u);
+        EXPECT_EQ(results[0].get<std::string>("name"), std::optional<std::string>("test_1"));
+        EXPECT_EQ(results[2].get<std::string>("name"), std::optional<std::string>("test_3"));
+    }
+}
+
+// -------------------- Tests: find / update / remove with query --------------------
+
+TEST_F(CollectionTest, Find_WhenQueryIsUsed_ReturnsSameDocumentsWithAndWithoutIndex) {
+    auto query = field("number") >= 2 && field("name") != "test_3";
+
+    auto scanned = collection.find(query);
+    collection.createIndex("number", IndexType::Ordered);
+    auto indexed = collection.find(query);
+    collection.createIndex("name");
+    auto hashed = collection.find(field("name") == "test_2" && field("number") > 0);
+
+    for (const auto& results : {scanned, indexed, hashed}) {
+        ASSERT_EQ(results.size(), 1u);
+        EXPECT_EQ(results[0].get<std::string>("name"), std::optional<std::string>("test_2"));
+    }
+}
+
+TEST_F(CollectionTest, UpdateAndRemove_WhenQueryIsUsed_UseIndexedDocuments) {
+    collection.createIndex("number", IndexType::Ordered);
+
+    auto updated = collection.update(field("number") < 3, [](Document& doc) { doc.set("number", 0); });
+    EXPECT_EQ(updated.size(), 2u);
+    EXPECT_EQ(collection.find(field("number") == 0).size(), 2u);
+
+    auto removed = collection.remove(field("number") <= 0);
+    EXPECT_EQ(removed.size(), 2u);
+    ASSERT_EQ(collection.getAll().size(), 1u);
+    EXPECT_EQ(collection.getAll()[0].get<int>("number"), std::optional<int>(3));
+}
+
+// -------------------- Tests: explain --------------------
+
+class CollectionPlannerTest : public ::testing::Test {
+protected:
+    Collection collection = Collection("PlannerCollection");
+
+    void SetUp() override {
+        for (int i = 0; i < 100; ++i) {
+            Document doc;
+            doc.set("age", i);
+            doc.set("group", i % 2);
+            doc.set("name", std::string("doc_") + std::to_string(i % 10));
+            collection.insert(doc);
+        }
+    }
+};
+
+TEST_F(CollectionPlannerTest, Explain_WhenNoIndexExists_ChoosesFullScan) {
+    auto plan = collection.explain(field("age") >= 10 && field("age") < 20);
+
+    EXPECT_TRUE(plan.isFullScan());
+    EXPECT_EQ(plan.estimatedScanned, 100u);
+    EXPECT_EQ(plan.scanned, 100u);
+    EXPECT_EQ(plan.returned, 10u);
+    EXPECT_EQ(plan.residual.size(), 2u);
+}
+
+TEST_F(CollectionPlannerTest, Explain_WhenRangeIsIndexed_ScansOnlyRange) {
+    collection.createIndex("age", IndexType::Ordered);
+    auto plan = collection.explain(field("age") >= 10 && field("age") < 20 && field("group") == 0);
+
+    ASSERT_EQ(plan.accessPaths.size(), 1u);
+    EXPECT_EQ(plan.accessPaths[0].type, IndexType::Ordered);
+    EXPECT_EQ(plan.estimatedScanned, 10u);
+    EXPECT_EQ(plan.scanned, 10u);
+    EXPECT_EQ(plan.returned, 5u);
+    ASSERT_EQ(plan.residual.size(), 1u);
+    EXPECT_EQ(plan.residual[0].field, "group");
+}
+
+TEST_F(CollectionPlannerTest, Explain_WhenIndexIsNotSelective_ChoosesFullScan) {
+    collection.createIndex("group");
+    auto plan = collection.explain(field("group") == 1);
+
+    EXPECT_TRUE(plan.isFullScan());
+    EXPECT_EQ(plan.returned, 50u);
+}
+
+TEST_F(CollectionPlannerTest, Explain_WhenTwoIndexesAreSelective_IntersectsThem) {
+    collection.createIndex("name");
+    collection.createIndex("age", IndexType::Ordered);
+    auto plan = collection.explain(field("name") == "doc_3" && field("age") < 40);
+
+    ASSERT_EQ(plan.accessPaths.size(), 2u);
+    EXPECT_EQ(plan.accessPaths[0].type, IndexType::Hash);
+    EXPECT_EQ(plan.scanned, 4u);
+    EXPECT_EQ(plan.returned, 4u);
+    EXPECT_TRUE(plan.residual.empty());
+    EXPECT_FALSE(plan.toString().empty());
+}
+
+TEST_F(CollectionPlannerTest, Find_WhenPlannedWithIndexes_ReturnsSameAsScan) {
+    auto query = field("age") > 5 && field("age") <= 50 && field("name") == "doc_5" && (field("group") == 1 || field("age") == 6);
+    auto scanned = collection.find(query);
+
+    collection.createIndex("name");
+    collection.createIndex("age", IndexType::Ordered);
+    auto plan = collection.explain(query);
+    auto indexed = collection.find(query);
+
+    EXPECT_FALSE(plan.isFullScan());
+    EXPECT_FALSE(plan.complete);
+    EXPECT_EQ(scanned, indexed);
+    EXPECT_EQ(indexed.size(), 4u);
+}
+
+// -------------------- Tests: find<Filter> with Execution --------------------
+
+TEST(CollectionParallelTest, Find_WhenParallel_ReturnsSameDocumentsAsSequential) {
+    Collection col("ParallelCollection");
+    for (int i = 0; i < 20000; ++i) {
+        Document doc;
+        doc.set("number", i);
+        col.insert(doc);
+    }
+
+    auto filter = [](const Document& doc) { return *doc.get<int>("number") % 7 == 0; };
+    auto sequential = col.find(filter);
+    auto parallel = col.find(filter, Execution::Parallel);
+    auto unordered = col.find(field("number") >= 100, Execution::ParallelUnordered);
+
+    EXPECT_EQ(parallel, sequential);
+    EXPECT_EQ(unordered.size(), 19900u);
+}
+
+// -------------------- Tests: findView / getAllView --------------------
+
+TEST_F(CollectionTest, FindView_YieldsReferencesToMatchingDocuments) {
+    auto view = collection.findView([](const Document& doc) { return *doc.get<int>("number") >= 2; });
+
+    std::vector<const Document*> found;
+    for (const auto& doc : view) {
+        found.push_back(&doc);
+    }
+
+    ASSERT_EQ(found.size(), 2u);
+    auto copies = collection.find([](const Document& doc) { return *doc.get<int>("number") >= 2; });
+    EXPECT_EQ(*found[0], copies[0]);
+    EXPECT_EQ(*found[1], copies[1]);
+}
+
+TEST_F(CollectionTest, FindView_WhenQueryIsIndexed_YieldsSameDocumentsAsFind) {
+    collection.createIndex("name");
+    auto view = collection.findView(field("name") == "test_3");
+
+    auto it = view.begin();
+    ASSERT_NE(it, view.end());
+    EXPECT_EQ(it->get<int>("number"), std::optional<int>(3));
+    EXPECT_EQ(++it, view.end());
+    EXPECT_TRUE(collection.findView(field("name") == "missing").empty());
+}
+
+TEST_F(CollectionTest, GetAllView_YieldsAllDocuments) {
+    auto view = collection.getAllView();
+    EXPECT_EQ(std::distance(view.begin(), view.end()), 3);
+}
+
+// -------------------- Tests: find with Projection --------------------
+
+class CollectionProjectionTest : public ::testing::Test {
+protected:
+    Collection collection = Collection("ProjectionCollection");
+
+    void SetUp() override {
+        Document location;
+        location.set("city", std::string("Krakow"));
+        location.set("zip", std::string("30-001"));
+
+        Document address;
+        address.set("location", location);
+        address.set("street", std::string("Main"));
+
+        Document first;
+        first.set("sku", std::string("a"));
+        first.set("qty", 1);
+        Document second;
+        second.set("sku", std::string("b"));
+        second.set("qty", 2);
+
+        Document doc;
+        doc.set("name", std::string("test"));
+        doc.set("number", 1);
+        doc.set("address", address);
+        doc.set("items", Document::Vector{first, second});
+        collection.insert(doc);
+    }
+};
+
+TEST_F(CollectionProjectionTest, Find_WhenIncluding_KeepsOnlySelectedPathsAndId) {
+    auto found = collection.find(field("number") == 1, Projection::include({"name", "address.location.city", "items.sku"}));
+
+    ASSERT_EQ(found.size(), 1u);
+    const auto& doc = found[0];
+    EXPECT_EQ(doc.getDataView().size(), 4u);
+    EXPECT_TRUE(doc.get<size_t>("id").has_value());
+    EXPECT_EQ(doc.get<std::string>("name"), std::optional<std::string>("test"));
+    EXPECT_FALSE(doc.get<int>("number").has_value());
+
+    auto address = doc.get<Document>("address");
+    ASSERT_TRUE(address.has_value());
+    EXPECT_FALSE(address->get<std::string>("street").has_value());
+    auto location = address->get<Document>("location");
+    ASSERT_TRUE(location.has_value());
+    EXPECT_EQ(location->get<std::string>("city"), std::optional<std::string>("Krakow"));
+    EXPECT_FALSE(location->get<std::string>("zip").has_value());
+
+    auto items = doc.get<Document::Vector>("items");
+    ASSERT_TRUE(items.has_value());
+    ASSERT_EQ(items->size(), 2u);
+    EXPECT_EQ((*items)[1].get<std::string>("sku"), std::optional<std::string>("b"));
+    EXPECT_FALSE((*items)[1].get<int>("qty").has_value());
+}
+
+TEST_F(CollectionProjectionTest, Find_WhenExcluding_DropsOnlySelectedPaths) {
+    auto found = collection.find([](const Document&) { return true; },
+                                 Projection::exclude({"number", "address.location.zip", "items.qty"}));
+
+    ASSERT_EQ(found.size(), 1u);
+    const auto& doc = found[0];
+    EXPECT_FALSE(doc.get<int>("number").has_value());
+    EXPECT_EQ(doc.get<std::string>("name"), std::optional<std::string>("test"));
+
+    auto address = doc.get<Document>("address");
+    ASSERT_TRUE(address.has_value());
+    EXPECT_EQ(address->get<std::string>("street"), std::optional<std::string>("Main"));
+    auto location = address->get<Document>("location");
+    ASSERT_TRUE(location.has_value());
+    EXPECT_EQ(location->get<std::string>("city"), std::optional<std::string>("Krakow"));
+    EXPECT_FALSE(location->get<std::string>("zip").has_value());
+
+    auto items = doc.get<Document::Vector>("items");
+    ASSERT_TRUE(items.has_value());
+    EXPECT_EQ((*items)[0].get<std::string>("sku"), std::optional<std::string>("a"));
+    EXPECT_FALSE((*items)[0].get<int>("qty").has_value());
+}
+
+TEST_F(CollectionProjectionTest, Find_WhenPathDoesNotExist_OmitsIt) {
+    auto found = collection.find(field("number") == 1, Projection::include({"missing", "name.nested"}));
+
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0].getDataView().size(), 1u);
+    EXPECT_TRUE(found[0].get<size_t>("id").has_value());
+}
+
+TEST_F(CollectionPlannerTest, Remove_WhenManyDocumentsMatch_KeepsIdLookupsAndIndexesValid) {
+    collection.createIndex("age", IndexType::Ordered);
+    auto survivors = collection.find(field("group") == 1);
+
+    auto removed = collection.remove(field("group") == 0);
+
+    EXPECT_EQ(removed.size(), 50u);
+    EXPECT_EQ(collection.getAll(), survivors);
+    for (const auto& doc : survivors) {
+        auto found = collection.getDocumentById(*doc.get<size_t>("id"));
+        ASSERT_TRUE(found.has_value());
+        EXPECT_EQ(*found, doc);
+    }
+    for (auto id : removed) {
+        EXPECT_FALSE(collection.getDocumentById(id).has_value());
+    }
+    EXPECT_EQ(collection.find(field("age") >= 90).size(), 5u);
+}
+
+TEST_F(CollectionPlannerTest, GetHandle_StaysValidAcrossInsertsAndRemoves) {
+    auto doc = collection.find(field("age") == 99).front();
+    auto handle = collection.getHandle(*doc.get<size_t>("id"));
+    ASSERT_TRUE(handle.has_value());
+
+    collection.remove(field("age") < 50);
+    for (int i = 0; i < 10; ++i) {
+        Document extra;
+        extra.set("age", 100 + i);
+        collection.insert(extra);
+    }
+
+    const auto* found = collection.getDocument(*handle);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(*found, doc);
+
+    collection.remove(doc);
+    EXPECT_EQ(collection.getDocument(*handle), nullptr);
+    EXPECT_FALSE(collection.getHandle(*doc.get<size_t>("id")).has_value());
+}
+
+TEST_F(CollectionTest, Insert_WhenDocumentIsMoved_ReturnsIdOfStoredDocument) {
+    Document doc;
+    doc.set("name", std::string("moved"));
+
+    auto id = collection.insert(std::move(doc));
+
+    ASSERT_TRUE(id.has_value());
+    auto stored = collection.getDocumentById(*id);
+    ASSERT_TRUE(stored.has_value());
+    EXPECT_EQ(stored->get<std::string>("name"), std::optional<std::string>("moved"));
+
+    Document duplicate;
+    duplicate.set("id", *id);
+    EXPECT_FALSE(collection.insert(std::move(duplicate)).has_value());
+}
+
+TEST(CollectionIdStrategyTest, Insert_WhenMonotonic_AssignsSequentialIds) {
+    Collection col("MonotonicCollection", IdStrategy::Monotonic);
+    Document first, explicitId, second;
+    explicitId.set("id", size_t{100});
+
+    col.insert(first);
+    col.insert(explicitId);
+    col.insert(second);
+
+    EXPECT_EQ(first.get<size_t>("id"), std::optional<size_t>(1));
+    EXPECT_EQ(second.get<size_t>("id"), std::optional<size_t>(101));
+    EXPECT_EQ(col.getIdStrategy(), IdStrategy::Monotonic);
+}
+
+// -------------------- Tests: insertMany --------------------
+
+TEST_F(CollectionTest, InsertMany_SkipsDuplicatedIdsAndIndexesDocuments) {
+    collection.createIndex("name");
+    auto existingId = *collection.getAll()[0].get<size_t>("id");
+
+    std::vector<Document> docs(4);
+    docs[0].set("name", std::string("bulk"));
+    docs[1].set("id", existingId);
+    docs[2].set("id", size_t{7});
+    docs[2].set("name", std::string("bulk"));
+    docs[3].set("id", size_t{7});
+
+    auto ids = collection.insertMany(std::move(docs));
+
+    ASSERT_EQ(ids.size(), 2u);
+    EXPECT_EQ(ids[1], 7u);
+    EXPECT_EQ(collection.getAll().size(), 5u);
+    EXPECT_EQ(collection.findEqual("name", std::string("bulk")).size(), 2u);
+    EXPECT_TRUE(collection.getDocumentById(ids[0]).has_value());
+}
+
+// -------------------- Tests: find with FindOptions --------------------
+
+TEST_F(CollectionPlannerTest, Find_WithSkipAndLimit_ReturnsPageInCollectionOrder) {
+    FindOptions options;
+    options.skip = 5;
+    options.limit = 3;
+
+    auto found = collection.find(field("group") == 0, options);
+
+    ASSERT_EQ(found.size(), 3u);
+    EXPECT_EQ(found[0].get<int>("age"), std::optional<int>(10));
+    EXPECT_EQ(found[2].get<int>("age"), std::optional<int>(14));
+}
+
+TEST_F(CollectionPlannerTest, Find_WithSortAndLimit_ReturnsTopResults) {
+    FindOptions options;
+    options.limit = 3;
+    options.sort = SortKey{"age", false};
+    options.projection = Projection::include({"age"});
+
+    auto found = collection.find([](const Document& doc) { return *doc.get<int>("group") == 1; }, options);
+
+    ASSERT_EQ(found.size(), 3u);
+    EXPECT_EQ(found[0].get<int>("age"), std::optional<int>(99));
+    EXPECT_EQ(found[1].get<int>("age"), std::optional<int>(97));
+    EXPECT_EQ(found[2].get<int>("age"), std::optional<int>(95));
+    EXPECT_FALSE(found[0].get<int>("group").has_value());
+}
+
+TEST_F(CollectionPlannerTest, Find_WithSortAndSkip_KeepsCollectionOrderForEqualKeys) {
+    FindOptions options;
+    options.skip = 8;
+    options.limit = 4;
+    options.sort = SortKey{"name"};
+
+    auto found = collection.find([](const Document&) { return true; }, options);
+
+    ASSERT_EQ(found.size(), 4u);
+    EXPECT_EQ(found[0].get<int>("age"), std::optional<int>(80));
+    EXPECT_EQ(found[1].get<int>("age"), std::optional<int>(90));
+    EXPECT_EQ(found[2].get<int>("age"), std::optional<int>(1));
+    EXPECT_EQ(found[3].get<int>("age"), std::optional<int>(11));
+}
+
+TEST_F(CollectionTest, Find_WithSort_PutsDocumentsWithoutKeyLast) {
+    Document doc;
+    doc.set("name", std::string("no_number"));
+    collection.insert(doc);
+
+    FindOptions options;
+    options.sort = SortKey{"number", false};
+
+    auto found = collection.find([](const Document&) { return true; }, options);
+
+    ASSERT_EQ(found.size(), 4u);
+    EXPECT_EQ(found[0].get<int>("number"), std::optional<int>(3));
+    EXPECT_EQ(found[3].get<std::string>("name"), std::optional<std::string>("no_number"));
+}
+
+// -------------------- Tests: aggregate --------------------
+
+TEST_F(CollectionPlannerTest, Aggregate_GroupsAndAccumulatesMatchingDocuments) {
+    auto aggregation = Aggregation().groupBy("group").count("total").sum("sum", "age")
+        .min("youngest", "age").max("oldest", "age").avg("average", "age");
+
+    auto results = collection.aggregate(field("age") < 10, aggregation);
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].get<int>("group"), std::optional<int>(0));
+    EXPECT_EQ(results[0].get<size_t>("total"), std::optional<size_t>(5));
+    EXPECT_EQ(results[0].get<double>("sum"), std::optional<double>(20.0));
+    EXPECT_EQ(results[0].get<int>("youngest"), std::optional<int>(0));
+    EXPECT_EQ(results[0].get<int>("oldest"), std::optional<int>(8));
+    EXPECT_EQ(results[0].get<double>("average"), std::optional<double>(4.0));
+    EXPECT_EQ(results[1].get<int>("group"), std::optional<int>(1));
+    EXPECT_EQ(results[1].get<double>("sum"), std::optional<double>(25.0));
+}
+
+TEST_F(CollectionPlannerTest, Aggregate_WithoutGrouping_ReturnsSingleGroup) {
+    auto results = collection.aggregate([](const Document&) { return true; },
+                                        Aggregation().count("total").avg("average", "name").max("last", "name"));
+
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].get<size_t>("total"), std::optional<size_t>(100));
+    EXPECT_FALSE(results[0].get<double>("average").has_value());
+    EXPECT_EQ(results[0].get<std::string>("last"), std::optional<std::string>("doc_9"));
+}
+
+TEST(CollectionParallelTest, Aggregate_WhenParallel_ReturnsSameResultsAsSequential) {
+    Collection col("ParallelCollection");
+    for (int i = 0; i < 20000; ++i) {
+        Document doc;
+        doc.set("number", i);
+        if (i % 100 != 0) {
+            doc.set("category", std::string("category_") + std::to_string(i % 7));
+        }
+        col.insert(doc);
+    }
+
+    auto aggregation = Aggregation().groupBy("category").count("total").sum("sum", "number").max("max", "number");
+    auto sequential = col.aggregate(field("number") >= 10, aggregation);
+    auto parallel = col.aggregate(field("number") >= 10, aggregation, Execution::Parallel);
+
+    EXPECT_EQ(sequential.size(), 8u);
+    EXPECT_EQ(parallel, sequential);
+}
@@ -290,6 +290,359 @@ TEST_F(DatabaseTests, Find_WhenCollectionDoesNotExist_ReturnEmpty) {
     EXPECT_TRUE(results.empty());
 }
 
+// -------------------- Tests: findEqual --------------------
+
+TEST_F(DatabaseTests, FindEqual_WhenIndexed_ReflectsUpdates) {
+    db.insert(collectionName, createDocumentWithId(1, "A"));
+    db.insert(collectionName, createDocumentWithId(2, "B"));
+    db.createIndex(collectionName, "name");
+
+    db.update(collectionName,
+        [](const Document& doc) { return doc.get<std::string>("name") == std::optional<std::string>("A"); },
+        [](Document& doc) { doc.set("name", std::string("C")); }
+    );
+
+    EXPECT_TRUE(db.findEqual(collectionName, "name", std::string("A")).empty());
+    auto results = db.findEqual(collectionName, "name", std::string("C"));
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].get<size_t>("id"), std::optional<size_t>(1));
+}
+
+TEST_F(DatabaseTests, FindEqual_WhenCollectionDoesNotExist_ReturnEmpty) {
+    EXPECT_TRUE(db.findEqual("nonexistent", "name", std::string("A")).empty());
+}
+
+// -------------------- Tests: insertMany --------------------
+
+TEST_F(DatabaseTests, InsertMany_InsertsAndPersistsDocuments) {
+    std::vector<Document> docs{createDocumentWithId(1, "A"), createDocumentWithId(2, "B")};
+    Document withoutId;
+    withoutId.set("name", std::string("C"));
+    docs.push_back(withoutId);
+
+    auto ids = db.insertMany(collectionName, std::move(docs));
+
+    ASSERT_EQ(ids.size(), 3u);
+    EXPECT_EQ(ids[0], 1u);
+    EXPECT_EQ(db.getAll(collectionName).size(), 3u);
+
+    Database reopened(dbPath);
+    auto loaded = reopened.findEqual(collectionName, "name", std::string("C"));
+    ASSERT_EQ(loaded.size(), 1u);
+    EXPECT_EQ(loaded[0].get<size_t>("id"), std::optional<size_t>(ids[2]));
+}
+
+TEST_F(DatabaseTests, InsertMany_WhenCollectionDoesNotExist_ReturnsEmpty) {
+    EXPECT_TRUE(db.insertMany("nonexistent", {createDocumentWithId(1)}).empty());
+}
+
+TEST_F(DatabaseTests, Constructor_WhenMonotonic_ContinuesAfterLoadedIds) {
+    db.insert(collectionName, createDocumentWithId(41));
+
+    Database reopened(dbPath, IdStrategy::Monotonic);
+    Document doc;
+    doc.set("name", std::string("next"));
+    reopened.insert(collectionName, doc);
+
+    auto found = reopened.findEqual(collectionName, "name", std::string("next"));
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0].get<size_t>("id"), std::optional<size_t>(42));
+}
+
+TEST_F(DatabaseTests, ConvertStorage_KeepsDocumentsAndSavesInNewFormat) {
+    db.insert(collectionName, createDocumentWithId(1, "A"));
+
+    db.convertStorage(StorageFormat::Binary);
+    db.insert(collectionName, createDocumentWithId(2, "B"));
+
+    EXPECT_TRUE(std::filesystem::exists(dbPath + "/" + collectionName + "/1.bin"));
+    EXPECT_TRUE(std::filesystem::exists(dbPath + "/" + collectionName + "/2.bin"));
+
+    Database reopened(dbPath, DatabaseOptions{IdStrategy::Random, StorageFormat::Binary});
+    EXPECT_EQ(reopened.getAll(collectionName).size(), 2u);
+}
+
+TEST_F(DatabaseTests, Constructor_WhenSegment_RestoresUpdatedAndRemovedDocuments) {
+    Database segment(dbPath, DatabaseOptions{IdStrategy::Random, StorageFormat::Segment});
+    segment.addCollection("segments");
+    segment.insert("segments", createDocumentWithId(1, "A"));
+    segment.insert("segments", createDocumentWithId(2, "B"));
+    segment.insert("segments", createDocumentWithId(3, "C"));
+    segment.update("segments", [](const Document& doc) { return doc.get<size_t>("id") == std::optional<size_t>(1); },
+        [](Document& doc) { doc.set("name", std::string("Updated")); });
+    segment.remove("segments", [](const Document& doc) { return doc.get<size_t>("id") == std::optional<size_t>(2); });
+
+    Database reopened(dbPath, DatabaseOptions{IdStrategy::Random, StorageFormat::Segment});
+    auto docs = reopened.getAll("segments");
+    ASSERT_EQ(docs.size(), 2u);
+    EXPECT_EQ(reopened.findEqual("segments", "name", std::string("Updated")).size(), 1u);
+    EXPECT_TRUE(reopened.findEqual("segments", "name", std::string("B")).empty());
+}
+
+TEST_F(DatabaseTests, Constructor_WhenLoadingInParallel_LoadsSameCollectionsAsSequential) {
+    for(size_t c{0}; c < 6; ++c) {
+        auto name = "parallel" + std::to_string(c);
+        db.addCollection(name);
+        for(size_t id{1}; id <= 20; ++id) {
+            db.insert(name, createDocumentWithId(c * 100 + id, name));
+        }
+    }
+
+    DatabaseOptions parallelOptions;
+    parallelOptions.loading = Execution::Parallel;
+    DatabaseOptions sequentialOptions;
+    sequentialOptions.loading = Execution::Sequential;
+
+    Database parallel(dbPath, parallelOptions);
+    Database sequential(dbPath, sequentialOptions);
+
+    for(size_t c{0}; c < 6; ++c) {
+        auto name = "parallel" + std::to_string(c);
+        auto parallelDocs = parallel.getAll(name);
+        auto sequentialDocs = sequential.getAll(name);
+
+        ASSERT_EQ(parallelDocs.size(), 20u);
+        ASSERT_EQ(parallelDocs.size(), sequentialDocs.size());
+        for(size_t i{0}; i < parallelDocs.size(); ++i) {
+            EXPECT_EQ(parallelDocs[i].get<size_t>("id"), sequentialDocs[i].get<size_t>("id"));
+            EXPECT_EQ(parallelDocs[i].get<std::string>("name"), std::optional<std::string>(name));
+        }
+    }
+}
+
+// -------------------- Tests: lazy loading --------------------
+
+TEST_F(DatabaseTests, LazyLoading_LoadsCollectionOnFirstAccess) {
+    db.insert(collectionName, createDocumentWithId(1, "A"));
+
+    DatabaseOptions options;
+    options.lazyLoading = true;
+    Database lazy(dbPath, options);
+
+    EXPECT_FALSE(lazy.empty());
+    EXPECT_FALSE(lazy.isLoaded(collectionName));
+
+    auto docs = lazy.getAll(collectionName);
+    ASSERT_EQ(docs.size(), 1u);
+    EXPECT_EQ(docs[0].get<std::string>("name"), std::optional<std::string>("A"));
+    EXPECT_TRUE(lazy.isLoaded(collectionName));
+}
+
+TEST_F(DatabaseTests, LazyLoading_WhenInsertingIntoUnloadedCollection_KeepsExistingDocuments) {
+    db.insert(collectionName, createDocumentWithId(1, "A"));
+
+    DatabaseOptions options;
+    options.lazyLoading = true;
+    {
+        Database lazy(dbPath, options);
+        lazy.addCollection(collectionName);
+        lazy.insert(collectionName, createDocumentWithId(2, "B"));
+    }
+
+    Database reopened(dbPath);
+    EXPECT_EQ(reopened.getAll(collectionName).size(), 2u);
+}
+
+TEST_F(DatabaseTests, UnloadCollection_ReloadsDocumentsOnNextAccess) {
+    db.insert(collectionName, createDocumentWithId(1, "A"));
+
+    EXPECT_TRUE(db.unloadCollection(collectionName));
+    EXPECT_FALSE(db.isLoaded(collectionName));
+    EXPECT_FALSE(db.unloadCollection(collectionName));
+
+    EXPECT_EQ(db.findEqual(collectionName, "name", std::string("A")).size(), 1u);
+    EXPECT_TRUE(db.isLoaded(collectionName));
+}
+
+TEST_F(DatabaseTests, MaxLoadedCollections_UnloadsLeastRecentlyUsedCollection) {
+    db.addCollection("first");
+    db.addCollection("second");
+    db.insert("first", createDocumentWithId(1, "A"));
+    db.insert("second", createDocumentWithId(2, "B"));
+
+    DatabaseOptions options;
+    options.lazyLoading = true;
+    options.maxLoadedCollections = 2;
+    Database lazy(dbPath, options);
+
+    lazy.getAll("first");
+    lazy.getAll("second");
+    lazy.getAll(collectionName);
+
+    EXPECT_FALSE(lazy.isLoaded("first"));
+    EXPECT_TRUE(lazy.isLoaded("second"));
+    EXPECT_TRUE(lazy.isLoaded(collectionName));
+    EXPECT_EQ(lazy.getAll("first").size(), 1u);
+}
+
+TEST_F(DatabaseTests, MaxLoadedCollections_WhenCollectionHasLoggedMutations_KeepsItLoaded) {
+    db.addCollection("first");
+
+    DatabaseOptions options;
+    options.lazyLoading = true;
+    options.maxLoadedCollections = 1;
+    options.wal.enabled = true;
+    Database lazy(dbPath, options);
+
+    lazy.insert("first", createDocumentWithId(1, "A"));
+    lazy.getAll(collectionName);
+
+    EXPECT_TRUE(lazy.isLoaded("first"));
+    EXPECT_FALSE(lazy.unloadCollection("first"));
+
+    lazy.checkpoint();
+    EXPECT_TRUE(lazy.unloadCollection("first"));
+    EXPECT_EQ(lazy.getAll("first").size(), 1u);
+}
+
+TEST_F(DatabaseTests, MaxLoadedCollections_WhenCollectionWasHandedOut_KeepsItLoaded) {
+    db.addCollection("first");
+    db.insert("first", createDocumentWithId(1, "A"));
+
+    DatabaseOptions options;
+    options.lazyLoading = true;
+    options.maxLoadedCollections = 1;
+    Database lazy(dbPath, options);
+
+    auto first = lazy.getCollection("first");
+    ASSERT_TRUE(first.has_value());
+    lazy.getAll(collectionName);
+
+    EXPECT_TRUE(lazy.isLoaded("first"));
+    EXPECT_FALSE(lazy.unloadCollection("first"));
+    EXPECT_EQ(first->get().size(), 1u);
+}
+
+// -------------------- Tests: write-ahead log --------------------
+
+TEST_F(DatabaseTests, Wal_WhenEnabled_SavesDocumentFilesAtCheckpoint) {
+    DatabaseOptions options;
+    options.wal.enabled = true;
+    Database logged(dbPath, options);
+
+    logged.insert(collectionName, createDocumentWithId(1, "A"));
+    logged.update(collectionName, [](const Document&) { return true; }, [](Document& doc) { doc.set("name", std::string("B")); });
+    EXPECT_FALSE(std::filesystem::exists(dbPath + "/" + collectionName + "/1.txt"));
+
+    logged.checkpoint();
+    EXPECT_TRUE(std::filesystem::exists(dbPath + "/" + collectionName + "/1.txt"));
+
+    Database reopened(dbPath);
+    EXPECT_EQ(reopened.findEqual(collectionName, "name", std::string("B")).size(), 1u);
+}
+
+TEST_F(DatabaseTests, Wal_AfterCrash_ReplaysLoggedMutations) {
+    DatabaseOptions options;
+    options.wal.enabled = true;
+    {
+        Database logged(dbPath, options);
+        logged.insert(collectionName, createDocumentWithId(1, "A"));
+        logged.insert(collectionName, createDocumentWithId(2, "B"));
+        logged.remove(collectionName, [](const Document& doc) { return doc.get<size_t>("id") == std::optional<size_t>(1); });
+
+        // Log as it was before checkpoint taken on destruction
+        std::filesystem::copy_file(dbPath + "/wal.log", dbPath + "/wal.crash");
+    }
+
+    std::filesystem::remove_all(dbPath + "/" + collectionName);
+    std::filesystem::create_directory(dbPath + "/" + collectionName);
+    std::filesystem::rename(dbPath + "/wal.crash", dbPath + "/wal.log");
+
+    Database reopened(dbPath);
+    auto docs = reopened.getAll(collectionName);
+    ASSERT_EQ(docs.size(), 1u);
+    EXPECT_EQ(docs[0].get<std::string>("name"), std::optional<std::string>("B"));
+    EXPECT_TRUE(std::filesystem::exists(dbPath + "/" + collectionName + "/2.txt"));
+    EXPECT_FALSE(std::filesystem::exists(dbPath + "/wal.log"));
+}
+
+// -------------------- Tests: snapshots --------------------
+
+TEST_F(DatabaseTests, Snapshot_WhenEnabled_LoadsDocumentsAndIndexesFromIt) {
+    DatabaseOptions options;
+    options.snapshots = true;
+    {
+        Database snapshotted(dbPath, options);
+        snapshotted.insert(collectionName, createDocumentWithId(1, "A"));
+        snapshotted.insert(collectionName, createDocumentWithId(2, "B"));
+        snapshotted.createIndex(collectionName, "name", IndexType::Ordered);
+    }
+
+    EXPECT_TRUE(std::filesystem::exists(dbPath + "/" + collectionName + "/collection.snap"));
+    std::filesystem::remove(dbPath + "/" + collectionName + "/1.txt");
+    std::filesystem::remove(dbPath + "/" + collectionName + "/2.txt");
+
+    Database reopened(dbPath);
+    EXPECT_EQ(reopened.getAll(collectionName).size(), 2u);
+    EXPECT_TRUE(reopened.getCollection(collectionName)->get().hasIndex("name", IndexType::Ordered));
+}
+
+TEST_F(DatabaseTests, Snapshot_WhenDocumentFilesChangeWithoutLog_IsRemoved) {
+    DatabaseOptions options;
+    options.snapshots = true;
+    Database snapshotted(dbPath, options);
+    snapshotted.insert(collectionName, createDocumentWithId(1, "A"));
+    snapshotted.checkpoint();
+    EXPECT_TRUE(std::filesystem::exists(dbPath + "/" + collectionName + "/collection.snap"));
+
+    snapshotted.insert(collectionName, createDocumentWithId(2, "B"));
+    EXPECT_FALSE(std::filesystem::exists(dbPath + "/" + collectionName + "/collection.snap"));
+}
+
+TEST_F(DatabaseTests, Snapshot_WhenCollectionWasMutatedDirectly_DoesNotPersistMutation) {
+    DatabaseOptions options;
+    options.snapshots = true;
+    {
+        Database snapshotted(dbPath, options);
+        snapshotted.insert(collectionName, createDocumentWithId(1, "A"));
+        snapshotted.getCollection(collectionName)->get().insert(createDocumentWithId(2, "B"));
+    }
+
+    Database reopened(dbPath, options);
+    auto docs = reopened.getAll(collectionName);
+    ASSERT_EQ(docs.size(), 1u);
+    EXPECT_EQ(docs[0].get<std::string>("name"), std::optional<std::string>("A"));
+}
+
+TEST_F(DatabaseTests, Snapshot_WithWal_WhenCollectionWasMutatedDirectly_DoesNotPersistMutation) {
+    DatabaseOptions options;
+    options.snapshots = true;
+    options.wal.enabled = true;
+    {
+        Database logged(dbPath, options);
+        logged.insert(collectionName, createDocumentWithId(1, "A"));
+        logged.checkpoint();
+
+        logged.getCollection(collectionName)->get().insert(createDocumentWithId(2, "B"));
+        logged.insert(collectionName, createDocumentWithId(3, "C"));
+    }
+
+    Database reopened(dbPath, options);
+    EXPECT_EQ(reopened.getAll(collectionName).size(), 2u);
+    EXPECT_TRUE(reopened.findEqual(collectionName, "name", std::string("B")).empty());
+}
+
+TEST_F(DatabaseTests, Snapshot_WithWal_ReplaysOnlyRecordsAfterIt) {
+    DatabaseOptions options;
+    options.snapshots = true;
+    options.wal.enabled = true;
+    {
+        Database logged(dbPath, options);
+        logged.insert(collectionName, createDocumentWithId(1, "A"));
+        std::filesystem::copy_file(dbPath + "/wal.log", dbPath + "/wal.old");
+
+        logged.update(collectionName, [](const Document&) { return true; }, [](Document& doc) { doc.set("name", std::string("Z")); });
+    }
+
+    // Log with record already covered by snapshot, as if crash happened before it was reset
+    std::filesystem::rename(dbPath + "/wal.old", dbPath + "/wal.log");
+
+    Database reopened(dbPath, options);
+    auto docs = reopened.getAll(collectionName);
+    ASSERT_EQ(docs.size(), 1u);
+    EXPECT_EQ(docs[0].get<std::string>("name"), std::optional<std::string>("Z"));
+}
+
 // -------------------- Tests: remove<Filter> --------------------
 
 TEST_F(DatabaseTests, Remove_WhenFilteredByFieldValue_RemoveCorrectDocuments) {
@@ -511,6 +864,71 @@ TEST_F(DatabaseTests, GetAll_ReturnsCopy_NotReference) {
     EXPECT_NE(original[0].get<size_t>("id"), 999);
 }
 
+// -------------------- Tests: findView / getAllView --------------------
+
+TEST_F(DatabaseTests, FindView_YieldsMatchingDocuments) {
+    db.insert(collectionName, createDocumentWithId(1, "A"));
+    db.insert(collectionName, createDocumentWithId(2, "B"));
+
+    auto view = db.findView(collectionName, field("name") == "B");
+    auto it = view.begin();
+    ASSERT_NE(it, view.end());
+    EXPECT_EQ(it->get<size_t>("id"), std::optional<size_t>(2));
+
+    auto all = db.getAllView(collectionName);
+    EXPECT_EQ(std::distance(all.begin(), all.end()), 2);
+}
+
+TEST_F(DatabaseTests, FindView_WhenCollectionDoesNotExist_IsEmpty) {
+    EXPECT_TRUE(db.findView("nonexistent", field("name") == "B").empty());
+    EXPECT_TRUE(db.getAllView("nonexistent").empty());
+}
+
+// -------------------- Tests: find with Projection --------------------
+
+TEST_F(DatabaseTests, Find_WithProjection_ReturnsProjectedDocuments) {
+    db.insert(collectionName, createDocumentWithId(1, "A"));
+    db.insert(collectionName, createDocumentWithId(2, "B"));
+
+    auto found = db.find(collectionName, field("name") == "B", Projection::exclude({"name"}));
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0].get<size_t>("id"), std::optional<size_t>(2));
+    EXPECT_FALSE(found[0].get<std::string>("name").has_value());
+
+    EXPECT_TRUE(db.find("nonexistent", field("name") == "B", Projection::include({"name"})).empty());
+}
+
+TEST_F(DatabaseTests, Find_WithOptions_ReturnsLimitedSortedDocuments) {
+    db.insert(collectionName, createDocumentWithId(1, "B"));
+    db.insert(collectionName, createDocumentWithId(2, "A"));
+    db.insert(collectionName, createDocumentWithId(3, "C"));
+
+    FindOptions options;
+    options.limit = 2;
+    options.sort = SortKey{"name"};
+
+    auto found = db.find(collectionName, [](const Document&) { return true; }, options);
+    ASSERT_EQ(found.size(), 2u);
+    EXPECT_EQ(found[0].get<size_t>("id"), std::optional<size_t>(2));
+    EXPECT_EQ(found[1].get<size_t>("id"), std::optional<size_t>(1));
+}
+
+// -------------------- Tests: aggregate --------------------
+
+TEST_F(DatabaseTests, Aggregate_CountsDocumentsByField) {
+    db.insert(collectionName, createDocumentWithId(1, "A"));
+    db.insert(collectionName, createDocumentWithId(2, "B"));
+    db.insert(collectionName, createDocumentWithId(3, "A"));
+
+    auto results = db.aggregate(collectionName, [](const Document&) { return true; },
+                                Aggregation().groupBy("name").count("total"));
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].get<std::string>("name"), std::optional<std::string>("A"));
+    EXPECT_EQ(results[0].get<size_t>("total"), std::optional<size_t>(2));
+
+    EXPECT_TRUE(db.aggregate("nonexistent", [](const Document&) { return true; }, Aggregation().count("total")).empty());
+}
+
 // -------------------- Tests: getCollectionCopy --------------------
 
 TEST_F(DatabaseTests, GetCollectionCopy_WhenCollectionExists_ReturnsIndependentCopy) {
@@ -56,6 +56,46 @@ TEST_F(DocumentTests, Get_WhenPassedKeyIsIdAndValueIsNotSizeT_ThrowException) {
     ASSERT_THROW(doc.set("id", 1), std::invalid_argument); 
 }
 
+TEST_F(DocumentTests, Set_WhenValueIsRvalue_MovesIt) {
+    Document::Vector items(3);
+    const auto* buffer = items.data();
+
+    doc.set("items", std::move(items));
+
+    const auto& stored = std::get<Document::Vector>(doc.getDataView().at("items"));
+    EXPECT_EQ(stored.size(), 3u);
+    EXPECT_EQ(stored.data(), buffer);
+}
+
+TEST_F(DocumentTests, Set_WhenValueIsConstRvalue_CopiesIt) {
+    const std::string name("A");
+    const int number{1};
+    const size_t id{7};
+
+    doc.set("name", std::move(name));
+    doc.set("number", std::move(number));
+    doc.set("id", std::move(id));
+
+    EXPECT_EQ(doc.get<std::string>("name"), std::optional<std::string>("A"));
+    EXPECT_EQ(doc.get<int>("number"), std::optional<int>(1));
+    EXPECT_EQ(doc.get<size_t>("id"), std::optional<size_t>(7));
+    ASSERT_THROW(doc.set("id", std::move(number)), std::invalid_argument);
+}
+
+TEST_F(DocumentTests, Emplace_WhenTypeIsConst_ConstructsValueInPlace) {
+    doc.emplace<const std::string>("name", "A");
+    doc.emplace<const size_t>("id", 7u);
+
+    EXPECT_EQ(doc.get<std::string>("name"), std::optional<std::string>("A"));
+    EXPECT_EQ(doc.get<size_t>("id"), std::optional<size_t>(7));
+}
+
+TEST_F(DocumentTests, Emplace_ConstructsValueInPlace) {
+    doc.emplace<std::string>("name", 3, 'x');
+    EXPECT_EQ(doc.get<std::string>("name"), std::optional<std::string>("xxx"));
+    ASSERT_THROW(doc.emplace<int>("id", 1), std::invalid_argument);
+}
+
 // -------------------- Tests: get<T> --------------------
 
 TEST_F(DocumentTests, Get_WhenIntExists_ReturnIt) {
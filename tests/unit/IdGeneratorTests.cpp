@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include "IdGenerator.hpp"
+
+// -------------------- Tests: next --------------------
+
+TEST(IdGeneratorTests, Next_WhenRandom_AvoidsTakenIds) {
+    IdGenerator generator;
+    std::unordered_set<size_t> taken;
+    for (int i = 0; i < 1000; ++i) {
+        auto id = generator.next(taken);
+        EXPECT_TRUE(taken.insert(id).second);
+    }
+}
+
+TEST(IdGeneratorTests, Next_WhenMonotonic_ContinuesAfterObservedIds) {
+    IdGenerator generator(IdStrategy::Monotonic);
+    EXPECT_EQ(generator.next({}), 1u);
+    EXPECT_EQ(generator.next({}), 2u);
+
+    generator.observe(10);
+    generator.observe(5);
+
+    EXPECT_EQ(generator.next({}), 11u);
+}
+
+TEST(IdGeneratorTests, Next_WhenTimeOrdered_ReturnsStrictlyIncreasingIds) {
+    IdGenerator generator(IdStrategy::TimeOrdered);
+    size_t previous = generator.next({});
+    for (int i = 0; i < 10000; ++i) {
+        auto id = generator.next({});
+        ASSERT_GT(id, previous);
+        previous = id;
+    }
+
+    generator.observe(previous + 1000);
+    EXPECT_GT(generator.next({}), previous + 1000);
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include "MappedFile.hpp"
+
+#include <fstream>
+
+class MappedFileTests : public ::testing::Test {
+protected:
+    std::filesystem::path filePath = "test_mapped.bin";
+
+    void TearDown() override {
+        std::filesystem::remove(filePath);
+    }
+
+    void writeFile(const std::string& contents) {
+        std::ofstream(filePath, std::ios::binary) << contents;
+    }
+};
+
+// -------------------- Tests: MappedFile --------------------
+
+TEST_F(MappedFileTests, Data_WhenFileIsSmall_ReadsItIntoBuffer) {
+    writeFile("small file");
+
+    MappedFile file(filePath);
+    EXPECT_FALSE(file.isMapped());
+    EXPECT_EQ(file.data(), "small file");
+}
+
+TEST_F(MappedFileTests, Data_WhenFileIsLarge_MapsWholeFile) {
+    std::string contents(MappedFile::mapThreshold * 3 + 17, '\0');
+    for(size_t i{0}; i < contents.size(); ++i) {
+        contents[i] = static_cast<char>('a' + i % 26);
+    }
+    writeFile(contents);
+
+    MappedFile file(filePath);
+    EXPECT_TRUE(file.isMapped());
+    EXPECT_EQ(file.data(), contents);
+}
+
+TEST_F(MappedFileTests, Data_WhenFileIsEmpty_IsEmpty) {
+    writeFile("");
+
+    MappedFile file(filePath);
+    EXPECT_TRUE(file.data().empty());
+}
+
+TEST_F(MappedFileTests, Constructor_WhenFileDoesNotExist_Throws) {
+    EXPECT_THROW(MappedFile("missing_mapped.bin"), std::runtime_error);
+}
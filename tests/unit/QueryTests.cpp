@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include "Query.hpp"
+
+class QueryTests : public ::testing::Test {
+protected:
+    Document doc;
+
+    void SetUp() override {
+        doc.set("name", std::string("x"));
+        doc.set("age", 15);
+        doc.set("score", 2.5);
+        doc.set("active", true);
+    }
+};
+
+// -------------------- Tests: Comparison --------------------
+
+TEST_F(QueryTests, Comparison_WhenComparingWithConstant_ReturnsExpectedResult) {
+    EXPECT_TRUE((field("age") == 15)(doc));
+    EXPECT_FALSE((field("age") != 15)(doc));
+    EXPECT_TRUE((field("age") > 10)(doc));
+    EXPECT_TRUE((field("age") >= 15)(doc));
+    EXPECT_FALSE((field("age") < 15)(doc));
+    EXPECT_TRUE((field("age") <= 15)(doc));
+    EXPECT_TRUE((field("name") == "x")(doc));
+    EXPECT_TRUE((field("active") == true)(doc));
+}
+
+TEST_F(QueryTests, Comparison_NumericAlternativesAreComparedByValue) {
+    EXPECT_TRUE((field("age") == static_cast<size_t>(15))(doc));
+    EXPECT_TRUE((field("age") == 15.0)(doc));
+    EXPECT_TRUE((field("score") > 2)(doc));
+    EXPECT_TRUE((field("score") < static_cast<size_t>(3))(doc));
+}
+
+TEST_F(QueryTests, Comparison_WhenFieldIsMissingOrNotComparable_OnlyNotEqualMatches) {
+    EXPECT_FALSE((field("missing") == 1)(doc));
+    EXPECT_TRUE((field("missing") != 1)(doc));
+    EXPECT_FALSE((field("name") > 1)(doc));
+}
+
+// -------------------- Tests: And / Or / Not --------------------
+
+TEST_F(QueryTests, LogicalOperators_CombineExpressions) {
+    EXPECT_TRUE((field("age") > 10 && field("name") == "x")(doc));
+    EXPECT_FALSE((field("age") > 20 && field("name") == "x")(doc));
+    EXPECT_TRUE((field("age") > 20 || field("name") == "x")(doc));
+    EXPECT_TRUE((!(field("age") > 20))(doc));
+}
+
+TEST_F(QueryTests, CollectConjuncts_ReturnsPredicatesOfConjunctionOnly) {
+    std::vector<Predicate> predicates;
+    (field("age") >= 10 && field("age") < 20 && (field("a") == 1 || field("b") == 2)).collectConjuncts(predicates);
+
+    ASSERT_EQ(predicates.size(), 2u);
+    EXPECT_EQ(predicates[0].field, "age");
+    EXPECT_EQ(predicates[0].op, Operator::GreaterEqual);
+    EXPECT_EQ(predicates[1].op, Operator::Less);
+    EXPECT_EQ(predicates[1].value, Document::Value(20));
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include "SlotMap.hpp"
+
+#include <string>
+
+// -------------------- Tests: insert / get --------------------
+
+TEST(SlotMapTests, Insert_ReturnsHandleResolvingToValue) {
+    SlotMap<std::string> map;
+    auto first = map.insert("a");
+    auto second = map.insert("b");
+
+    ASSERT_NE(map.get(first), nullptr);
+    EXPECT_EQ(*map.get(first), "a");
+    EXPECT_EQ(*map.get(second), "b");
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(map.handleAt(1), second);
+}
+
+// -------------------- Tests: erase --------------------
+
+TEST(SlotMapTests, Erase_KeepsOtherHandlesValid) {
+    SlotMap<std::string> map;
+    auto first = map.insert("a");
+    auto second = map.insert("b");
+    auto third = map.insert("c");
+
+    EXPECT_TRUE(map.erase(first));
+
+    EXPECT_EQ(map.get(first), nullptr);
+    EXPECT_EQ(*map.get(second), "b");
+    EXPECT_EQ(*map.get(third), "c");
+    EXPECT_EQ(map.position(third), std::optional<size_t>(0));
+    EXPECT_FALSE(map.erase(first));
+}
+
+TEST(SlotMapTests, Erase_WhenSlotIsReused_RejectsStaleHandle) {
+    SlotMap<std::string> map;
+    auto stale = map.insert("a");
+    map.erase(stale);
+
+    auto fresh = map.insert("b");
+
+    EXPECT_EQ(fresh.index, stale.index);
+    EXPECT_FALSE(map.contains(stale));
+    EXPECT_EQ(map.get(stale), nullptr);
+    EXPECT_EQ(*map.get(fresh), "b");
+}
+
+TEST(SlotMapTests, ErasePositions_KeepsOrderAndHandlesOfRemainingValues) {
+    SlotMap<int> map;
+    std::vector<SlotHandle> handles;
+    for (int i = 0; i < 10; ++i) {
+        handles.push_back(map.insert(i));
+    }
+
+    map.erasePositions({0, 3, 4, 9});
+
+    EXPECT_EQ(map.values(), (std::vector<int>{1, 2, 5, 6, 7, 8}));
+    for (int i : {1, 2, 5, 6, 7, 8}) {
+        ASSERT_NE(map.get(handles[i]), nullptr);
+        EXPECT_EQ(*map.get(handles[i]), i);
+    }
+    for (int i : {0, 3, 4, 9}) {
+        EXPECT_FALSE(map.contains(handles[i]));
+    }
+}
@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 
+#include "BinaryCodec.hpp"
 #include "Storage.hpp"
 
 #include <fstream>
+#include <sstream>
+#include <thread>
 
 class StorageTests : public ::testing::Test {
 protected:
@@ -140,6 +143,51 @@ TEST_F(StorageTests, SaveDocument_WhenMapIsNested_CreatesExpectedFile) {
     }
 }
 
+TEST_F(StorageTests, SaveDocument_FormatsNumbersAsOutputStream) {
+    for(double value : {0.1, 3.14159265, -1e+20, 1e-7, 123456789.0, 100.0}) {
+        Document doc;
+        doc.set<size_t>("id", 15);
+        doc.set("value", value);
+        storage.saveDocument(collectionPath, doc);
+
+        std::ostringstream expected;
+        expected << "\tvalue (double) : " << value;
+
+        std::ifstream file(collectionPath + "/15.txt");
+        std::string line;
+        bool found = false;
+        while (std::getline(file, line)) {
+            found = found || line == expected.str();
+        }
+        EXPECT_TRUE(found) << expected.str();
+    }
+}
+
+TEST_F(StorageTests, SaveDocuments_WhenFileExists_ReplacesItsWholeContents) {
+    Document large = createSampleDocument(16);
+    large.set<std::string>("padding", std::string(1000, 'x'));
+    storage.saveDocument(collectionPath, large);
+
+    auto first = createSampleDocument(16);
+    auto second = createSampleDocument(17);
+    storage.saveDocuments(collectionPath, {&first, &second});
+
+    auto loaded = storage.loadDocuments(collectionPath);
+    ASSERT_EQ(loaded.size(), 2u);
+    for(const auto& doc : loaded) {
+        EXPECT_FALSE(doc.get<std::string>("padding").has_value());
+    }
+}
+
+TEST_F(StorageTests, SyncDocuments_WhenDocumentsWereSavedAndRemoved_Succeeds) {
+    auto kept = createSampleDocument(18);
+    auto removed = createSampleDocument(19);
+    storage.saveDocuments(collectionPath, {&kept, &removed});
+    storage.removeDocument(collectionPath, 19);
+
+    EXPECT_NO_THROW(storage.syncDocuments(collectionPath, {18, 19}));
+}
+
 // -------------------- Tests: loadDocuments --------------------
 
 TEST_F(StorageTests, LoadDocuments_ReadsBackData) {
@@ -221,4 +269,313 @@ TEST_F(StorageTests, RemoveDocument_DeletesFile) {
 
     storage.removeDocument(collectionPath, 31);
     EXPECT_FALSE(std::filesystem::exists(path));
-}
\ No newline at end of file
+}
+// -------------------- Tests: StorageFormat::Binary --------------------
+
+TEST_F(StorageTests, SaveDocument_WhenBinary_RoundTripsAllTypes) {
+    Storage binary(StorageFormat::Binary);
+
+    Document item;
+    item.set<size_t>("id", 2);
+    item.set("flag", true);
+
+    Document nested;
+    nested.set<size_t>("id", 3);
+    nested.set("ratio", 0.1);
+
+    auto doc = createSampleDocument(1);
+    doc.set("negative", -7);
+    doc.set("large", std::numeric_limits<size_t>::max());
+    doc.set("empty", std::string());
+    doc.set("nested", nested);
+    doc.set("items", Document::Vector{item, item});
+    doc.set("map", Document::Map{{"key with spaces", nested}});
+
+    binary.saveDocument(collectionPath, doc);
+
+    EXPECT_TRUE(std::filesystem::exists(collectionPath + "/1.bin"));
+    auto loaded = storage.loadDocuments(collectionPath);
+    ASSERT_EQ(loaded.size(), 1u);
+    EXPECT_EQ(loaded[0], doc);
+}
+
+TEST_F(StorageTests, LoadDocuments_WhenTextValuesAreEdgeCases_ReadsThemBackExactly) {
+    Document nested;
+    nested.set<std::string>("note", "a (b) : c");
+
+    Document doc;
+    doc.set<size_t>("id", 18446744073709551615ull);
+    doc.set<int>("negative", -2147483647 - 1);
+    doc.set<double>("large", 1.5e+300);
+    doc.set<double>("small", -2.5e-7);
+    doc.set<std::string>("empty", "");
+    doc.set<std::string>("spaced", "  leading and inner  spaces");
+    doc.set<bool>("flag", false);
+    doc.set("vector", Document::Vector{nested, nested});
+    doc.set("map", Document::Map{{"key", nested}});
+
+    storage.saveDocument(collectionPath, doc);
+
+    auto loaded = storage.loadDocuments(collectionPath);
+    ASSERT_EQ(loaded.size(), 1u);
+    EXPECT_EQ(loaded[0].get<size_t>("id"), std::optional<size_t>(18446744073709551615ull));
+    EXPECT_EQ(loaded[0].get<int>("negative"), std::optional<int>(-2147483647 - 1));
+    EXPECT_EQ(loaded[0].get<double>("large"), std::optional<double>(1.5e+300));
+    EXPECT_EQ(loaded[0].get<double>("small"), std::optional<double>(-2.5e-7));
+    EXPECT_EQ(loaded[0].get<std::string>("empty"), std::optional<std::string>(""));
+    EXPECT_EQ(loaded[0].get<std::string>("spaced"), std::optional<std::string>("  leading and inner  spaces"));
+    EXPECT_EQ(loaded[0].get<bool>("flag"), std::optional<bool>(false));
+    EXPECT_EQ(loaded[0].get<Document::Vector>("vector"), std::optional<Document::Vector>(Document::Vector{nested, nested}));
+    EXPECT_EQ(loaded[0].get<Document::Map>("map"), std::optional<Document::Map>(Document::Map{{"key", nested}}));
+}
+
+TEST_F(StorageTests, LoadDocuments_WhenTextNumberIsMalformed_SkipsDocument) {
+    std::ofstream(collectionPath + "/3.txt") << "{\n\tid (size_t) : 3\n\tvalue (int) : abc\n}";
+    EXPECT_TRUE(storage.loadDocuments(collectionPath).empty());
+}
+
+TEST_F(StorageTests, LoadDocuments_WhenBinaryFileIsTruncated_SkipsIt) {
+    std::ofstream(collectionPath + "/5.bin", std::ios::binary) << "DDB\x01\x05";
+    EXPECT_TRUE(storage.loadDocuments(collectionPath).empty());
+}
+
+TEST_F(StorageTests, LoadDocuments_WhenParallel_ReturnsDocumentsInSameOrderAsSequential) {
+    for(size_t id{1}; id <= 50; ++id) {
+        storage.saveDocument(collectionPath, createSampleDocument(id));
+    }
+    std::ofstream(collectionPath + "/99.bin", std::ios::binary) << "DDB\x01\x05";
+
+    auto sequential = storage.loadDocuments(collectionPath, Execution::Sequential);
+    auto parallel = storage.loadDocuments(collectionPath, Execution::Parallel);
+
+    ASSERT_EQ(sequential.size(), 50u);
+    ASSERT_EQ(parallel.size(), sequential.size());
+    for(size_t i{0}; i < parallel.size(); ++i) {
+        EXPECT_EQ(parallel[i].get<size_t>("id"), sequential[i].get<size_t>("id"));
+    }
+}
+
+TEST_F(StorageTests, ConvertCollection_RewritesTextFilesAsBinary) {
+    auto doc = createSampleDocument(7);
+    storage.saveDocument(collectionPath, doc);
+
+    storage.convertCollection(collectionPath, StorageFormat::Binary);
+
+    EXPECT_FALSE(std::filesystem::exists(collectionPath + "/7.txt"));
+    EXPECT_TRUE(std::filesystem::exists(collectionPath + "/7.bin"));
+    auto loaded = storage.loadDocuments(collectionPath);
+    ASSERT_EQ(loaded.size(), 1u);
+    EXPECT_EQ(loaded[0], doc);
+
+    storage.removeDocument(collectionPath, 7);
+    EXPECT_FALSE(std::filesystem::exists(collectionPath + "/7.bin"));
+}
+
+// -------------------- Tests: StorageFormat::Segment --------------------
+
+TEST_F(StorageTests, SaveDocument_WhenSegment_AppendsToSingleSegmentFile) {
+    Storage segment(StorageFormat::Segment);
+
+    for(size_t id{1}; id <= 3; ++id) {
+        segment.saveDocument(collectionPath, createSampleDocument(id));
+    }
+
+    size_t files{0};
+    for(const auto& entry : std::filesystem::directory_iterator(collectionPath)) {
+        EXPECT_EQ(entry.path().extension(), ".seg");
+        ++files;
+    }
+    EXPECT_EQ(files, 1u);
+
+    Storage reopened(StorageFormat::Segment);
+    auto loaded = reopened.loadDocuments(collectionPath);
+    ASSERT_EQ(loaded.size(), 3u);
+    EXPECT_EQ(loaded[0], createSampleDocument(1));
+    EXPECT_EQ(loaded[2], createSampleDocument(3));
+}
+
+TEST_F(StorageTests, LoadDocuments_WhenSegment_ReturnsLatestVersionsWithoutRemoved) {
+    Storage segment(StorageFormat::Segment);
+    segment.saveDocument(collectionPath, createSampleDocument(1));
+    segment.saveDocument(collectionPath, createSampleDocument(2));
+
+    auto updated = createSampleDocument(1);
+    updated.set("value", 7);
+    segment.saveDocument(collectionPath, updated);
+    segment.removeDocument(collectionPath, 2);
+
+    Storage reopened(StorageFormat::Segment);
+    auto loaded = reopened.loadDocuments(collectionPath);
+    ASSERT_EQ(loaded.size(), 1u);
+    EXPECT_EQ(loaded[0].get<int>("value"), std::optional<int>(7));
+}
+
+TEST_F(StorageTests, LoadDocuments_WhenSegmentHasTornTail_TruncatesIt) {
+    Storage segment(StorageFormat::Segment);
+    segment.saveDocument(collectionPath, createSampleDocument(1));
+
+    auto segmentPath = collectionPath + "/00000001.seg";
+    auto size = std::filesystem::file_size(segmentPath);
+    {
+        std::ofstream file(segmentPath, std::ios::binary | std::ios::app);
+        file << "\x01partial";
+    }
+
+    Storage reopened(StorageFormat::Segment);
+    EXPECT_EQ(reopened.loadDocuments(collectionPath).size(), 1u);
+    EXPECT_EQ(std::filesystem::file_size(segmentPath), size);
+
+    reopened.saveDocument(collectionPath, createSampleDocument(2));
+    Storage again(StorageFormat::Segment);
+    EXPECT_EQ(again.loadDocuments(collectionPath).size(), 2u);
+}
+
+TEST_F(StorageTests, SegmentStore_WhenSegmentIsFull_StartsNewOne) {
+    SegmentStore store(collectionPath, 1);
+    store.put(createSampleDocument(1));
+    store.put(createSampleDocument(2));
+    EXPECT_TRUE(store.remove(1));
+    EXPECT_FALSE(store.remove(1));
+
+    EXPECT_TRUE(std::filesystem::exists(collectionPath + "/00000002.seg"));
+    EXPECT_TRUE(std::filesystem::exists(collectionPath + "/00000003.seg"));
+    EXPECT_EQ(store.get(2), std::optional<Document>(createSampleDocument(2)));
+    EXPECT_EQ(store.get(1), std::nullopt);
+
+    SegmentStore reopened(collectionPath, 1);
+    auto loaded = reopened.load();
+    ASSERT_EQ(loaded.size(), 1u);
+    EXPECT_EQ(loaded[0], createSampleDocument(2));
+}
+
+TEST_F(StorageTests, ConvertCollection_BetweenTextAndSegment_KeepsDocuments) {
+    storage.saveDocument(collectionPath, createSampleDocument(1));
+    storage.saveDocument(collectionPath, createSampleDocument(2));
+
+    storage.convertCollection(collectionPath, StorageFormat::Segment);
+    EXPECT_FALSE(std::filesystem::exists(collectionPath + "/1.txt"));
+    EXPECT_EQ(storage.loadDocuments(collectionPath).size(), 2u);
+
+    storage.convertCollection(collectionPath, StorageFormat::Text);
+    EXPECT_TRUE(std::filesystem::exists(collectionPath + "/1.txt"));
+    EXPECT_FALSE(std::filesystem::exists(collectionPath + "/00000001.seg"));
+    EXPECT_EQ(storage.loadDocuments(collectionPath).size(), 2u);
+}
+
+// -------------------- Tests: segment compaction --------------------
+
+TEST_F(StorageTests, SegmentStore_Stats_TrackDeadRecords) {
+    SegmentStore store(collectionPath);
+    store.put(createSampleDocument(1));
+    store.put(createSampleDocument(1));
+
+    auto stats = store.stats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].liveBytes * 2, stats[0].totalBytes);
+    EXPECT_DOUBLE_EQ(stats[0].deadRatio(), 0.5);
+}
+
+TEST_F(StorageTests, SegmentStore_Compact_DropsDeadRecordsAndKeepsLiveDocuments) {
+    SegmentStore store(collectionPath, 1);
+    store.put(createSampleDocument(1));
+    store.put(createSampleDocument(2));
+
+    auto updated = createSampleDocument(1);
+    updated.set("value", 7);
+    store.put(updated);
+    store.remove(2);
+    store.put(createSampleDocument(3));
+
+    EXPECT_EQ(store.compact(0.5), 2u);
+    EXPECT_FALSE(std::filesystem::exists(collectionPath + "/00000001.seg"));
+    EXPECT_FALSE(std::filesystem::exists(collectionPath + "/00000002.seg"));
+    EXPECT_EQ(store.get(1), std::optional<Document>(updated));
+    EXPECT_EQ(store.compact(0.5), 0u);
+
+    SegmentStore reopened(collectionPath, 1);
+    auto loaded = reopened.load();
+    ASSERT_EQ(loaded.size(), 2u);
+    EXPECT_EQ(loaded[0], updated);
+    EXPECT_EQ(loaded[1], createSampleDocument(3));
+}
+
+TEST_F(StorageTests, SegmentStore_Compact_KeepsTombstoneWhileOlderSegmentHoldsDocument) {
+    std::string encoded;
+    BinaryCodec::encode(createSampleDocument(1), encoded);
+    auto recordSize = 17 + encoded.size();
+
+    std::vector<Document> docs{createSampleDocument(1), createSampleDocument(5), createSampleDocument(6), createSampleDocument(7)};
+    SegmentStore store(collectionPath, 2 * recordSize);
+    store.put(std::vector<const Document*>{&docs[0], &docs[1], &docs[2], &docs[3]});
+    store.put(createSampleDocument(2));
+    store.remove(1);
+    store.put(createSampleDocument(2));
+    store.put(createSampleDocument(3));
+
+    // Only second segment is dead enough, first one still holds removed document
+    EXPECT_EQ(store.compact(0.4), 1u);
+    EXPECT_TRUE(std::filesystem::exists(collectionPath + "/00000001.seg"));
+
+    SegmentStore reopened(collectionPath);
+    auto loaded = reopened.load();
+    ASSERT_EQ(loaded.size(), 5u);
+    EXPECT_FALSE(reopened.contains(1));
+    EXPECT_TRUE(reopened.contains(2));
+}
+
+TEST_F(StorageTests, SegmentStore_Compact_WhenDocumentsWereRemoved_CountsTombstonesAsDead) {
+    std::string encoded;
+    BinaryCodec::encode(createSampleDocument(1), encoded);
+    auto recordSize = 17 + encoded.size();
+
+    SegmentStore store(collectionPath, 2 * recordSize);
+    store.put(createSampleDocument(1));
+    store.remove(1);
+    store.put(createSampleDocument(5));
+    store.put(createSampleDocument(6));
+
+    auto stats = store.stats();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].totalBytes - stats[0].liveBytes, recordSize + 17);
+    EXPECT_GT(stats[0].deadRatio(), 0.5);
+
+    // Only removal made first segment dead, oldest segment also drops its tombstone
+    EXPECT_EQ(store.compact(0.5), 1u);
+    EXPECT_EQ(std::filesystem::file_size(collectionPath + "/00000001.seg"), recordSize);
+    EXPECT_EQ(store.compact(0.5), 0u);
+
+    SegmentStore reopened(collectionPath);
+    EXPECT_EQ(reopened.load().size(), 2u);
+    EXPECT_FALSE(reopened.contains(1));
+}
+
+TEST_F(StorageTests, SegmentStore_Compact_WhenThrottled_TakesAtLeastAllowedTime) {
+    SegmentStore store(collectionPath, 1);
+    store.put(createSampleDocument(1));
+    store.put(createSampleDocument(1));
+    store.put(createSampleDocument(2));
+
+    auto size = std::filesystem::file_size(collectionPath + "/00000001.seg");
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(store.compact(0.5, size * 10), 1u);
+
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(90));
+}
+
+TEST_F(StorageTests, Compactor_WhenEnabled_CompactsInBackground) {
+    auto store = std::make_shared<SegmentStore>(collectionPath, 1);
+    store->put(createSampleDocument(1));
+    store->put(createSampleDocument(1));
+    store->put(createSampleDocument(2));
+
+    Compactor compactor(CompactionOptions{true, 0.5, 0, std::chrono::milliseconds(10)});
+    compactor.track(store);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(std::filesystem::exists(collectionPath + "/00000001.seg") && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    EXPECT_FALSE(std::filesystem::exists(collectionPath + "/00000001.seg"));
+    EXPECT_EQ(store->size(), 2u);
+}
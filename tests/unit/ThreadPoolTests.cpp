@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include "ThreadPool.hpp"
+
+#include <stdexcept>
+
+// -------------------- Tests: submit --------------------
+
+TEST(ThreadPoolTests, Submit_ReturnsResultOfTask) {
+    ThreadPool pool(2);
+    auto future = pool.submit([]() { return 42; });
+    EXPECT_EQ(future.get(), 42);
+}
+
+// -------------------- Tests: parallelFor --------------------
+
+TEST(ThreadPoolTests, ParallelFor_ProcessesEveryElementOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(10000);
+
+    pool.parallelFor(visits.size(), 37, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            ++visits[i];
+        }
+    });
+
+    for (const auto& count : visits) {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTests, ParallelFor_WhenCalledFromWorker_DoesNotDeadlock) {
+    ThreadPool pool(1);
+    std::atomic<size_t> total{0};
+
+    auto future = pool.submit([&]() {
+        pool.parallelFor(100, 10, [&](size_t, size_t begin, size_t end) { total += end - begin; });
+    });
+
+    future.get();
+    EXPECT_EQ(total.load(), 100u);
+}
+
+TEST(ThreadPoolTests, ParallelFor_WhenFunctionThrows_RethrowsInCaller) {
+    ThreadPool pool(2);
+    EXPECT_THROW(pool.parallelFor(10, 5, [](size_t chunk, size_t, size_t) {
+        if (chunk == 3) {
+            throw std::runtime_error("failed");
+        }
+    }), std::runtime_error);
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include "WriteAheadLog.hpp"
+
+#include <fstream>
+#include <thread>
+
+class WriteAheadLogTests : public ::testing::Test {
+protected:
+    std::filesystem::path logPath = "test_wal.log";
+
+    void TearDown() override {
+        std::filesystem::remove(logPath);
+    }
+
+    Document createDocument(size_t id) {
+        Document doc;
+        doc.set("id", id);
+        doc.set("name", std::string("Logged"));
+        return doc;
+    }
+};
+
+// -------------------- Tests: logPuts / logRemoves --------------------
+
+TEST_F(WriteAheadLogTests, Read_ReturnsCommittedRecordsInOrder) {
+    auto first = createDocument(1);
+    auto second = createDocument(2);
+    {
+        WriteAheadLog wal(logPath);
+        wal.logPuts("users", {&first, &second});
+        wal.logRemoves("users", {1});
+    }
+
+    WriteAheadLog reopened(logPath);
+    auto records = reopened.read();
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[0].type, WalRecord::Type::Put);
+    EXPECT_EQ(records[0].collection, "users");
+    EXPECT_EQ(records[0].doc, std::optional<Document>(first));
+    EXPECT_EQ(records[1].id, 2u);
+    EXPECT_EQ(records[2].type, WalRecord::Type::Remove);
+    EXPECT_EQ(records[2].doc, std::nullopt);
+    EXPECT_LT(records[0].lsn, records[1].lsn);
+    EXPECT_EQ(records[2].lsn, reopened.getLsn());
+}
+
+TEST_F(WriteAheadLogTests, LogPuts_FromManyThreads_KeepsEveryRecord) {
+    WriteAheadLog wal(logPath, SyncPolicy::Always);
+
+    std::vector<std::thread> threads;
+    for(size_t t{0}; t < 8; ++t) {
+        threads.emplace_back([&, t]() {
+            for(size_t i{0}; i < 25; ++i) {
+                auto doc = createDocument(t * 100 + i);
+                wal.logPuts("users", {&doc});
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    auto records = wal.read();
+    ASSERT_EQ(records.size(), 200u);
+    for(size_t i{1}; i < records.size(); ++i) {
+        EXPECT_LT(records[i - 1].lsn, records[i].lsn);
+    }
+}
+
+TEST_F(WriteAheadLogTests, LogPuts_WhenInterval_ReturnsWrittenRecords) {
+    auto doc = createDocument(1);
+    WriteAheadLog wal(logPath, SyncPolicy::Interval, std::chrono::milliseconds(5));
+    auto lsn = wal.logPuts("users", {&doc});
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(wal.read().size(), 1u);
+    EXPECT_EQ(wal.getLsn(), lsn);
+}
+
+// -------------------- Tests: recovery --------------------
+
+TEST_F(WriteAheadLogTests, Constructor_WhenTailIsTorn_TruncatesIt) {
+    auto doc = createDocument(1);
+    {
+        WriteAheadLog wal(logPath, SyncPolicy::Never);
+        wal.logPuts("users", {&doc});
+    }
+
+    auto size = std::filesystem::file_size(logPath);
+    {
+        std::ofstream file(logPath, std::ios::binary | std::ios::app);
+        file << "\x30\x00\x00\x00partial";
+    }
+
+    WriteAheadLog reopened(logPath, SyncPolicy::Never);
+    EXPECT_EQ(std::filesystem::file_size(logPath), size);
+    EXPECT_EQ(reopened.read().size(), 1u);
+
+    reopened.logRemoves("users", {1});
+    EXPECT_EQ(reopened.read().size(), 2u);
+}
+
+TEST_F(WriteAheadLogTests, Reset_DropsRecordsAndKeepsLsnGrowing) {
+    auto doc = createDocument(1);
+    WriteAheadLog wal(logPath);
+    auto before = wal.logPuts("users", {&doc});
+
+    wal.reset();
+    EXPECT_TRUE(wal.read().empty());
+    EXPECT_EQ(wal.getLsn(), before);
+
+    auto after = wal.logPuts("users", {&doc});
+    EXPECT_GT(after, before);
+
+    WriteAheadLog reopened(logPath);
+    auto records = reopened.read();
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].lsn, after);
+}